@@ -45,6 +45,10 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_TX_BUFFER_SIZE = "tx_buffer_size"
+CONF_SENSOR_BATCH_INTERVAL = "sensor_batch_interval"
+CONF_SESSION_RESUMPTION = "session_resumption"
+CONF_CONNECTION_STATS = "connection_stats"
 
 
 def validate_encryption_key(value):
@@ -82,9 +86,17 @@ CONFIG_SCHEMA = cv.Schema(
                 ),
             }
         ),
+        cv.Optional(CONF_TX_BUFFER_SIZE, default="4kB"): cv.All(
+            cv.validate_bytes, cv.int_range(min=2048, max=65535)
+        ),
+        cv.Optional(CONF_SENSOR_BATCH_INTERVAL): cv.All(
+            cv.requires_component("sensor"), cv.positive_time_period_milliseconds
+        ),
+        cv.Optional(CONF_CONNECTION_STATS, default=False): cv.boolean,
         cv.Optional(CONF_ENCRYPTION): cv.Schema(
             {
                 cv.Required(CONF_KEY): validate_encryption_key,
+                cv.Optional(CONF_SESSION_RESUMPTION, default=False): cv.boolean,
             }
         ),
     }
@@ -99,6 +111,12 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_tx_buffer_size(config[CONF_TX_BUFFER_SIZE]))
+    if CONF_SENSOR_BATCH_INTERVAL in config:
+        cg.add(var.set_sensor_batch_interval(config[CONF_SENSOR_BATCH_INTERVAL]))
+        cg.add_define("USE_API_SENSOR_BATCH")
+    if config[CONF_CONNECTION_STATS]:
+        cg.add_define("USE_API_CONNECTION_STATS")
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
@@ -120,6 +138,8 @@ async def to_code(config):
         decoded = base64.b64decode(encryption_config[CONF_KEY])
         cg.add(var.set_noise_psk(list(decoded)))
         cg.add_define("USE_API_NOISE")
+        if encryption_config[CONF_SESSION_RESUMPTION]:
+            cg.add_define("USE_API_NOISE_RESUMPTION")
         cg.add_library("esphome/noise-c", "0.1.4")
     else:
         cg.add_define("USE_API_PLAINTEXT")
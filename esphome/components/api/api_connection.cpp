@@ -1,4 +1,5 @@
 #include "api_connection.h"
+#include <algorithm>
 #include <cerrno>
 #include <cinttypes>
 #include "esphome/components/network/util.h"
@@ -25,6 +26,20 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+/// Stop adding messages to a batch once it is this large, about what fits in one TCP segment.
+static const size_t API_BATCH_MAX_SIZE = 1400;
+/// Maximum number of iterator steps per batch, as steps skipping internal entities don't add anything to it.
+static const size_t API_BATCH_MAX_ITERATIONS = 32;
+#ifdef USE_API_SENSOR_BATCH
+/// Maximum number of sensors per BatchSensorStateResponse, 8 bytes each.
+static const size_t API_SENSOR_BATCH_MAX_SENSORS = 64;
+#endif
+#ifdef USE_API_CONNECTION_STATS
+/// Number of commands whose state update is timed at the same time, the oldest one is given up.
+static const size_t API_MAX_PENDING_COMMANDS = 4;
+/// A state update later than this after a command is not counted, the entity likely changed for another reason.
+static const uint32_t API_COMMAND_LATENCY_TIMEOUT_US = 10000000;
+#endif
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
@@ -37,9 +52,13 @@ APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *pa
 #else
 #error "No frame helper defined"
 #endif
+  helper_->set_tx_buffer_size(parent->get_tx_buffer_size());
 }
 void APIConnection::start() {
   this->last_traffic_ = millis();
+#ifdef USE_API_CONNECTION_STATS
+  this->connected_at_ = this->last_traffic_;
+#endif
 
   APIError err = helper_->init();
   if (err != APIError::OK) {
@@ -52,6 +71,14 @@ void APIConnection::start() {
 }
 
 APIConnection::~APIConnection() {
+  if (this->helper_->get_tx_buffer_high_water_mark() > 0) {
+    ESP_LOGD(TAG, "%s: Up to %zu bytes were waiting for the socket", this->client_info_.c_str(),
+             this->helper_->get_tx_buffer_high_water_mark());
+  }
+  if (this->deferred_state_count_ > 0) {
+    ESP_LOGD(TAG, "%s: %" PRIu32 " state update(s) were deferred, %" PRIu32 " coalesced", this->client_info_.c_str(),
+             this->deferred_state_count_, this->coalesced_state_count_);
+  }
 #ifdef USE_BLUETOOTH_PROXY
   if (bluetooth_proxy::global_bluetooth_proxy->get_api_connection() == this) {
     bluetooth_proxy::global_bluetooth_proxy->unsubscribe_api_connection(this);
@@ -83,7 +110,7 @@ void APIConnection::loop() {
     ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
     return;
   }
-  ReadPacketBuffer buffer;
+  ReadPacketBuffer &buffer = this->read_buffer_;
   err = helper_->read_packet(&buffer);
   if (err == APIError::WOULD_BLOCK) {
     // pass
@@ -100,13 +127,43 @@ void APIConnection::loop() {
   } else {
     this->last_traffic_ = millis();
     // read a packet
+#ifdef USE_API_CONNECTION_STATS
+    // Only count the message types the connection handles, and not the messages of peers that failed the setup or
+    // authentication check, so the counters can't be made to grow by sending made up types
+    if (this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]) && !this->remove_) {
+      APIMessageStats &stats = this->get_message_stats_(buffer.type);
+      stats.messages_received++;
+      stats.bytes_received += buffer.data_len;
+    }
+#else
     this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+#endif
     if (this->remove_)
       return;
   }
 
-  this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  // Collect queued states and as many entities as fit in one batch, which goes out with a single write
+  this->helper_->begin_batch();
+  this->send_deferred_states_();
+  if (!this->state_limits_.empty())
+    this->send_limited_states_();
+#ifdef USE_API_SENSOR_BATCH
+  this->send_sensor_batch_();
+#endif
+  for (size_t i = 0; i < API_BATCH_MAX_ITERATIONS && this->can_add_to_batch_(); i++) {
+    if (!this->list_entities_iterator_.is_active() && !this->initial_state_iterator_.is_active())
+      break;
+    this->list_entities_iterator_.advance();
+    this->initial_state_iterator_.advance();
+  }
+  if (this->remove_)
+    return;
+  err = this->helper_->end_batch();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Sending batch failed: %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+    return;
+  }
 
   const uint32_t keepalive = 60000;
   const uint32_t now = millis();
@@ -160,6 +217,169 @@ void APIConnection::loop() {
   }
 }
 
+bool APIConnection::can_add_to_batch_() {
+  return !this->remove_ && this->helper_->can_write_without_blocking() &&
+         this->helper_->get_batch_size() < API_BATCH_MAX_SIZE;
+}
+void APIConnection::send_deferred_states_() {
+  size_t sent = 0;
+  while (sent < this->deferred_states_.size() && this->can_add_to_batch_()) {
+    const DeferredState &deferred = this->deferred_states_[sent];
+    if (!deferred.send(&this->initial_state_iterator_, deferred.entity))
+      break;
+    this->state_sent_(deferred.entity);
+    sent++;
+  }
+  if (sent == 0)
+    return;
+  this->deferred_states_.erase(this->deferred_states_.begin(), this->deferred_states_.begin() + sent);
+  ESP_LOGV(TAG, "%s: Sent %zu deferred state update(s), %zu still queued", this->client_info_.c_str(), sent,
+           this->deferred_states_.size());
+}
+
+template<typename T>
+static void add_entities(std::vector<EntityBase *> &entities, const std::vector<T *> &domain_entities,
+                         const uint32_t *key) {
+  for (auto *entity : domain_entities) {
+    if (key == nullptr || entity->get_object_id_hash() == *key)
+      entities.push_back(entity);
+  }
+}
+void APIConnection::add_domain_entities_(std::vector<EntityBase *> &entities, const StringRef &domain,
+                                         const uint32_t *key) {
+#ifdef USE_BINARY_SENSOR
+  if (domain == "binary_sensor")
+    add_entities(entities, App.get_binary_sensors(), key);
+#endif
+#ifdef USE_COVER
+  if (domain == "cover")
+    add_entities(entities, App.get_covers(), key);
+#endif
+#ifdef USE_FAN
+  if (domain == "fan")
+    add_entities(entities, App.get_fans(), key);
+#endif
+#ifdef USE_LIGHT
+  if (domain == "light")
+    add_entities(entities, App.get_lights(), key);
+#endif
+#ifdef USE_SENSOR
+  if (domain == "sensor")
+    add_entities(entities, App.get_sensors(), key);
+#endif
+#ifdef USE_SWITCH
+  if (domain == "switch")
+    add_entities(entities, App.get_switches(), key);
+#endif
+#ifdef USE_TEXT_SENSOR
+  if (domain == "text_sensor")
+    add_entities(entities, App.get_text_sensors(), key);
+#endif
+#ifdef USE_CLIMATE
+  if (domain == "climate")
+    add_entities(entities, App.get_climates(), key);
+#endif
+#ifdef USE_NUMBER
+  if (domain == "number")
+    add_entities(entities, App.get_numbers(), key);
+#endif
+#ifdef USE_SELECT
+  if (domain == "select")
+    add_entities(entities, App.get_selects(), key);
+#endif
+#ifdef USE_LOCK
+  if (domain == "lock")
+    add_entities(entities, App.get_locks(), key);
+#endif
+#ifdef USE_MEDIA_PLAYER
+  if (domain == "media_player")
+    add_entities(entities, App.get_media_players(), key);
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  if (domain == "alarm_control_panel")
+    add_entities(entities, App.get_alarm_control_panels(), key);
+#endif
+}
+
+void APIConnection::subscribe_states(const SubscribeStatesRequest &msg) {
+  this->state_subscription_ = true;
+#ifdef USE_API_SENSOR_BATCH
+  this->batch_sensor_states_ = msg.batch_sensor_states;
+#endif
+
+  // Resolve the entities and domains to the entities themselves, so updates only need to look up their pointer.
+  // Entities of different domains can have the same key, so a key alone doesn't identify an entity.
+  this->filter_states_ = !msg.entities.empty() || !msg.domains.empty();
+  this->subscribed_entities_.clear();
+  for (const auto &entity : msg.entities)
+    this->add_domain_entities_(this->subscribed_entities_, entity.domain, &entity.key);
+  for (const auto &domain : msg.domains)
+    this->add_domain_entities_(this->subscribed_entities_, StringRef(domain), nullptr);
+  std::sort(this->subscribed_entities_.begin(), this->subscribed_entities_.end());
+
+  this->state_limits_.clear();
+  std::vector<EntityBase *> limited;
+  for (const auto &limit : msg.limits) {
+    if (limit.min_interval == 0 && limit.deadband <= 0.0f)
+      continue;
+    limited.clear();
+    this->add_domain_entities_(limited, limit.domain, &limit.key);
+    for (auto *entity : limited) {
+      this->state_limits_.push_back(
+          StateLimit{entity, limit.min_interval, limit.deadband, false, 0, NAN, nullptr, NAN, nullptr});
+    }
+  }
+  if (this->filter_states_ || !this->state_limits_.empty()) {
+    ESP_LOGD(TAG, "%s: Subscribed to the states of %zu entities, %zu with limits", this->client_info_.c_str(),
+             this->subscribed_entities_.size(), this->state_limits_.size());
+  }
+
+  this->initial_state_iterator_.begin();
+}
+bool APIConnection::limit_state_update_(EntityBase *entity, float value, SendStateFunc send) {
+  if (this->state_limits_.empty())
+    return false;
+  auto it = std::find_if(this->state_limits_.begin(), this->state_limits_.end(),
+                         [entity](const StateLimit &limit) { return limit.entity == entity; });
+  if (it == this->state_limits_.end())
+    return false;
+  StateLimit &limit = *it;
+
+  if (limit.pending != nullptr) {
+    // The held back update sends the latest state anyway
+    limit.pending_value = value;
+    this->coalesced_state_count_++;
+    return true;
+  }
+  if (limit.deadband > 0.0f && !std::isnan(value) && !std::isnan(limit.last_value) &&
+      std::fabs(value - limit.last_value) < limit.deadband)
+    return true;
+  const uint32_t now = millis();
+  if (limit.sent && now - limit.last_sent < limit.min_interval) {
+    limit.pending = entity;
+    limit.pending_value = value;
+    limit.send = send;
+    return true;
+  }
+  limit.sent = true;
+  limit.last_sent = now;
+  limit.last_value = value;
+  return false;
+}
+void APIConnection::send_limited_states_() {
+  const uint32_t now = millis();
+  for (auto &limit : this->state_limits_) {
+    if (limit.pending == nullptr || now - limit.last_sent < limit.min_interval)
+      continue;
+    if (!this->can_add_to_batch_() || !limit.send(&this->initial_state_iterator_, limit.pending))
+      return;
+    this->state_sent_(limit.entity);
+    limit.last_sent = now;
+    limit.last_value = limit.pending_value;
+    limit.pending = nullptr;
+  }
+}
+
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
   return App.get_name() + component_type + entity->get_object_id();
 }
@@ -242,6 +462,7 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
   cover::Cover *cover = App.get_cover_by_key(msg.key);
   if (cover == nullptr)
     return;
+  this->command_received_(cover);
 
   auto call = cover->make_call();
   if (msg.has_legacy_command) {
@@ -306,6 +527,7 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
   fan::Fan *fan = App.get_fan_by_key(msg.key);
   if (fan == nullptr)
     return;
+  this->command_received_(fan);
 
   auto call = fan->make_call();
   if (msg.has_state)
@@ -387,6 +609,7 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
   light::LightState *light = App.get_light_by_key(msg.key);
   if (light == nullptr)
     return;
+  this->command_received_(light);
 
   auto call = light->make_call();
   if (msg.has_state)
@@ -452,6 +675,42 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 }
 #endif
 
+#ifdef USE_API_SENSOR_BATCH
+bool APIConnection::add_sensor_to_batch(sensor::Sensor *sensor) {
+  if (!this->state_subscription_ || !this->batch_sensor_states_)
+    return false;
+  if (!this->is_state_subscribed(sensor) ||
+      this->limit_state_update_(sensor, sensor->state,
+                                &APIConnection::send_deferred_state_<sensor::Sensor, &InitialStateIterator::on_sensor>))
+    return true;
+  if (this->sensor_batch_.empty())
+    this->sensor_batch_start_ = millis();
+  if (std::find(this->sensor_batch_.begin(), this->sensor_batch_.end(), sensor) == this->sensor_batch_.end())
+    this->sensor_batch_.push_back(sensor);
+  return true;
+}
+void APIConnection::send_sensor_batch_() {
+  if (this->sensor_batch_.empty() || millis() - this->sensor_batch_start_ < this->parent_->get_sensor_batch_interval())
+    return;
+  size_t sent = 0;
+  while (sent < this->sensor_batch_.size() && this->can_add_to_batch_()) {
+    const size_t end = std::min(sent + API_SENSOR_BATCH_MAX_SENSORS, this->sensor_batch_.size());
+    BatchSensorStateResponse resp;
+    resp.keys.reserve(end - sent);
+    resp.states.reserve(end - sent);
+    for (size_t i = sent; i < end; i++) {
+      resp.keys.push_back(this->sensor_batch_[i]->get_object_id_hash());
+      resp.states.push_back(this->sensor_batch_[i]->state);
+    }
+    if (!this->send_batch_sensor_state_response(resp))
+      break;
+    sent = end;
+  }
+  // Sensors that did not fit go out with the next loop
+  this->sensor_batch_.erase(this->sensor_batch_.begin(), this->sensor_batch_.begin() + sent);
+}
+#endif
+
 #ifdef USE_SWITCH
 bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   if (!this->state_subscription_)
@@ -480,6 +739,7 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
   switch_::Switch *a_switch = App.get_switch_by_key(msg.key);
   if (a_switch == nullptr)
     return;
+  this->command_received_(a_switch);
 
   if (msg.state) {
     a_switch->turn_on();
@@ -589,6 +849,7 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
   climate::Climate *climate = App.get_climate_by_key(msg.key);
   if (climate == nullptr)
     return;
+  this->command_received_(climate);
 
   auto call = climate->make_call();
   if (msg.has_mode)
@@ -648,6 +909,7 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
   number::Number *number = App.get_number_by_key(msg.key);
   if (number == nullptr)
     return;
+  this->command_received_(number);
 
   auto call = number->make_call();
   call.set_value(msg.state);
@@ -686,6 +948,7 @@ void APIConnection::select_command(const SelectCommandRequest &msg) {
   select::Select *select = App.get_select_by_key(msg.key);
   if (select == nullptr)
     return;
+  this->command_received_(select);
 
   auto call = select->make_call();
   call.set_option(msg.state);
@@ -745,6 +1008,7 @@ void APIConnection::lock_command(const LockCommandRequest &msg) {
   lock::Lock *a_lock = App.get_lock_by_key(msg.key);
   if (a_lock == nullptr)
     return;
+  this->command_received_(a_lock);
 
   switch (msg.command) {
     case enums::LOCK_UNLOCK:
@@ -792,6 +1056,7 @@ void APIConnection::media_player_command(const MediaPlayerCommandRequest &msg) {
   media_player::MediaPlayer *media_player = App.get_media_player_by_key(msg.key);
   if (media_player == nullptr)
     return;
+  this->command_received_(media_player);
 
   auto call = media_player->make_call();
   if (msg.has_command) {
@@ -960,6 +1225,7 @@ void APIConnection::alarm_control_panel_command(const AlarmControlPanelCommandRe
   alarm_control_panel::AlarmControlPanel *a_alarm_control_panel = App.get_alarm_control_panel_by_key(msg.key);
   if (a_alarm_control_panel == nullptr)
     return;
+  this->command_received_(a_alarm_control_panel);
 
   auto call = a_alarm_control_panel->make_call();
   switch (msg.command) {
@@ -1092,6 +1358,105 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
     ESP_LOGV(TAG, "Could not find matching service!");
   }
 }
+#ifdef USE_COMPONENT_PROFILER
+ComponentProfileResponse APIConnection::component_profile(const ComponentProfileRequest &msg) {
+  ComponentProfileResponse resp{};
+  resp.uptime_us = millis_64() * 1000;
+  resp.components.reserve(App.get_components().size());
+  for (auto *component : App.get_components()) {
+    const auto &loop_stats = component->get_loop_stats();
+    const auto &scheduler_stats = component->get_scheduler_stats();
+    ComponentProfile profile;
+    profile.source = component->get_component_source();
+    profile.loop_count = loop_stats.count;
+    profile.loop_time_us = loop_stats.total_us;
+    profile.loop_max_us = loop_stats.max_us;
+    profile.scheduler_count = scheduler_stats.count;
+    profile.scheduler_time_us = scheduler_stats.total_us;
+    profile.scheduler_max_us = scheduler_stats.max_us;
+    resp.components.push_back(profile);
+  }
+  return resp;
+}
+#endif
+#ifdef USE_API_CONNECTION_STATS
+APIConnectionStats APIConnection::get_stats() const {
+  APIConnectionStats stats = this->stats_;
+  for (const auto &type_stats : this->message_stats_) {
+    stats.messages_received += type_stats.messages_received;
+    stats.bytes_received += type_stats.bytes_received;
+    stats.messages_sent += type_stats.messages_sent;
+    stats.bytes_sent += type_stats.bytes_sent;
+  }
+  stats.deferred_states = this->deferred_state_count_;
+  stats.dropped_states = this->coalesced_state_count_;
+  return stats;
+}
+ConnectionStatsResponse APIConnection::connection_stats(const ConnectionStatsRequest &msg) {
+  ConnectionStatsResponse resp;
+  const uint32_t now = millis();
+  for (const auto &client : this->parent_->get_clients()) {
+    if (client->remove_)
+      continue;
+    const APIConnectionStats stats = client->get_stats();
+    ConnectionStats connection;
+    connection.client_info = client->client_info_;
+    connection.connected_ms = now - client->connected_at_;
+    connection.send_buffer_full = stats.send_buffer_full;
+    connection.deferred_states = stats.deferred_states;
+    connection.dropped_states = stats.dropped_states;
+    connection.command_count = stats.command_count;
+    if (stats.command_count > 0)
+      connection.command_latency_avg_us = stats.command_latency_us / stats.command_count;
+    connection.command_latency_max_us = stats.command_latency_max_us;
+    connection.message_types.reserve(client->message_stats_.size());
+    for (const auto &type_stats : client->message_stats_) {
+      MessageTypeStats message_type;
+      message_type.type = type_stats.type;
+      message_type.messages_received = type_stats.messages_received;
+      message_type.bytes_received = type_stats.bytes_received;
+      message_type.messages_sent = type_stats.messages_sent;
+      message_type.bytes_sent = type_stats.bytes_sent;
+      connection.message_types.push_back(message_type);
+    }
+    resp.connections.push_back(std::move(connection));
+  }
+  return resp;
+}
+APIMessageStats &APIConnection::get_message_stats_(uint32_t type) {
+  auto it = std::lower_bound(this->message_stats_.begin(), this->message_stats_.end(), type,
+                             [](const APIMessageStats &stats, uint32_t type) { return stats.type < type; });
+  if (it == this->message_stats_.end() || it->type != type)
+    it = this->message_stats_.insert(it, APIMessageStats{type, 0, 0, 0, 0});
+  return *it;
+}
+void APIConnection::command_received_(EntityBase *entity) {
+  const uint32_t now = micros();
+  for (auto &pending : this->pending_commands_) {
+    if (pending.entity == entity) {
+      // The state update that follows reflects the latest command
+      pending.received_us = now;
+      return;
+    }
+  }
+  if (this->pending_commands_.size() >= API_MAX_PENDING_COMMANDS)
+    this->pending_commands_.erase(this->pending_commands_.begin());
+  this->pending_commands_.push_back(PendingCommand{entity, now});
+}
+void APIConnection::complete_command_(EntityBase *entity) {
+  auto it = std::find_if(this->pending_commands_.begin(), this->pending_commands_.end(),
+                         [entity](const PendingCommand &pending) { return pending.entity == entity; });
+  if (it == this->pending_commands_.end())
+    return;
+  const uint32_t latency = micros() - it->received_us;
+  this->pending_commands_.erase(it);
+  if (latency > API_COMMAND_LATENCY_TIMEOUT_US)
+    return;
+  this->stats_.command_count++;
+  this->stats_.command_latency_us += latency;
+  this->stats_.command_latency_max_us = std::max(this->stats_.command_latency_max_us, latency);
+}
+#endif
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
@@ -1111,14 +1476,21 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
       if (message_type != 29) {
         ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
       }
+#ifdef USE_API_CONNECTION_STATS
+      this->stats_.send_buffer_full++;
+#endif
       delay(0);
       return false;
     }
   }
 
   APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
-  if (err == APIError::WOULD_BLOCK)
+  if (err == APIError::WOULD_BLOCK) {
+#ifdef USE_API_CONNECTION_STATS
+    this->stats_.send_buffer_full++;
+#endif
     return false;
+  }
   if (err != APIError::OK) {
     on_fatal_error();
     if (err == APIError::SOCKET_WRITE_FAILED && errno == ECONNRESET) {
@@ -1128,6 +1500,11 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
     return false;
   }
+#ifdef USE_API_CONNECTION_STATS
+  APIMessageStats &stats = this->get_message_stats_(message_type);
+  stats.messages_sent++;
+  stats.bytes_sent += buffer.get_buffer()->size();
+#endif
   // Do not set last_traffic_ on send
   return true;
 }
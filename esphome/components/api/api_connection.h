@@ -7,7 +7,10 @@
 #include "esphome/core/application.h"
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 namespace esphome {
@@ -48,6 +51,13 @@ class APIConnection : public APIServerConnection {
   bool send_sensor_state(sensor::Sensor *sensor, float state);
   bool send_sensor_info(sensor::Sensor *sensor);
 #endif
+#ifdef USE_API_SENSOR_BATCH
+  /** Add a sensor whose state changed to the batch sent with the next BatchSensorStateResponse.
+   *
+   * Returns false if the client did not ask for batched sensor states, then the state has to be sent on its own.
+   */
+  bool add_sensor_to_batch(sensor::Sensor *sensor);
+#endif
 #ifdef USE_SWITCH
   bool send_switch_state(switch_::Switch *a_switch, bool state);
   bool send_switch_info(switch_::Switch *a_switch);
@@ -91,6 +101,45 @@ class APIConnection : public APIServerConnection {
   bool send_media_player_info(media_player::MediaPlayer *media_player);
   void media_player_command(const MediaPlayerCommandRequest &msg) override;
 #endif
+  /** Send the current state of an entity after it changed.
+   *
+   * If the socket has no room for it, the entity is queued and its state at the time the socket has room is sent
+   * instead. An entity is queued at most once, further changes while it is queued are coalesced into that send, so
+   * the client always ends up with the latest state while the queue is bounded by the number of entities.
+   */
+  template<typename T, bool (InitialStateIterator::*Send)(T *)> void send_state_update(T *entity) {
+    if (!this->state_subscription_ || this->remove_ || !this->is_state_subscribed(entity))
+      return;
+    if (this->limit_state_update_(entity, numeric_state_(entity), &APIConnection::send_deferred_state_<T, Send>))
+      return;
+    // Entities of different domains can share an object id and therefore a key, compare the entities themselves
+    for (auto &deferred : this->deferred_states_) {
+      if (deferred.entity == entity) {
+        this->coalesced_state_count_++;
+        return;
+      }
+    }
+    if (!(this->initial_state_iterator_.*Send)(entity)) {
+      this->deferred_states_.push_back(DeferredState{entity, &APIConnection::send_deferred_state_<T, Send>});
+      this->deferred_state_count_++;
+    } else {
+      this->state_sent_(entity);
+    }
+  }
+  /// Whether the client subscribed to the state of this entity, by itself or its domain.
+  bool is_state_subscribed(EntityBase *entity) const {
+    return !this->filter_states_ ||
+           std::binary_search(this->subscribed_entities_.begin(), this->subscribed_entities_.end(), entity);
+  }
+  /// Number of state updates that could not be sent right away and were queued.
+  uint32_t get_deferred_state_count() const { return this->deferred_state_count_; }
+  /// Number of state updates merged into an update that was already queued.
+  uint32_t get_coalesced_state_count() const { return this->coalesced_state_count_; }
+#ifdef USE_API_CONNECTION_STATS
+  /// Counters of this connection since it was opened.
+  APIConnectionStats get_stats() const;
+#endif
+
   bool send_log_message(int level, const char *tag, const char *line);
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
@@ -150,10 +199,7 @@ class APIConnection : public APIServerConnection {
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
   void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
-  void subscribe_states(const SubscribeStatesRequest &msg) override {
-    this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
-  }
+  void subscribe_states(const SubscribeStatesRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
     if (msg.dump_config)
@@ -168,6 +214,12 @@ class APIConnection : public APIServerConnection {
     return {};
   }
   void execute_service(const ExecuteServiceRequest &msg) override;
+#ifdef USE_COMPONENT_PROFILER
+  ComponentProfileResponse component_profile(const ComponentProfileRequest &msg) override;
+#endif
+#ifdef USE_API_CONNECTION_STATS
+  ConnectionStatsResponse connection_stats(const ConnectionStatsRequest &msg) override;
+#endif
 
   bool is_authenticated() override { return this->connection_state_ == ConnectionState::AUTHENTICATED; }
   bool is_connection_setup() override {
@@ -188,6 +240,71 @@ class APIConnection : public APIServerConnection {
 
   bool send_(const void *buf, size_t len, bool force);
 
+  struct DeferredState {
+    EntityBase *entity;
+    bool (*send)(InitialStateIterator *iterator, EntityBase *entity);
+  };
+  template<typename T, bool (InitialStateIterator::*Send)(T *)>
+  static bool send_deferred_state_(InitialStateIterator *iterator, EntityBase *entity) {
+    return (iterator->*Send)(static_cast<T *>(entity));
+  }
+  /// Send queued state updates, in the order they were queued, as long as the socket has room.
+  void send_deferred_states_();
+
+  using SendStateFunc = bool (*)(InitialStateIterator *iterator, EntityBase *entity);
+  /// Limits the client set for the state updates of one entity.
+  struct StateLimit {
+    EntityBase *entity;
+    uint32_t min_interval;
+    float deadband;
+    bool sent;
+    uint32_t last_sent;
+    float last_value;
+    /// Entity whose update is held back until min_interval has passed, its state at that time is sent.
+    EntityBase *pending;
+    float pending_value;
+    SendStateFunc send;
+  };
+  /** Apply the limits of the client to a state update.
+   *
+   * Returns true if the update must not be sent now, because it is within the deadband of the last sent state or
+   * because it came too early and is held back.
+   */
+  bool limit_state_update_(EntityBase *entity, float value, SendStateFunc send);
+  /// Add the entities of a domain, only the one with the given key unless key is nullptr.
+  void add_domain_entities_(std::vector<EntityBase *> &entities, const StringRef &domain, const uint32_t *key);
+  /// Send the held back updates whose min_interval has passed.
+  void send_limited_states_();
+  /// The numeric state deadbands apply to, NAN for entities without one.
+  static float numeric_state_(EntityBase *entity) { return NAN; }
+#ifdef USE_SENSOR
+  static float numeric_state_(sensor::Sensor *sensor) { return sensor->state; }
+#endif
+#ifdef USE_NUMBER
+  static float numeric_state_(number::Number *number) { return number->state; }
+#endif
+  /// Whether another message can be added to the batch of the current loop.
+  bool can_add_to_batch_();
+#ifdef USE_API_SENSOR_BATCH
+  /// Send the batched sensor states once the batch interval has passed since the first one was added.
+  void send_sensor_batch_();
+#endif
+#ifdef USE_API_CONNECTION_STATS
+  /// Counters of a message type, added in order of the type when it is first seen.
+  APIMessageStats &get_message_stats_(uint32_t type);
+  /// Remember when a command for an entity was received, to time the state update that follows it.
+  void command_received_(EntityBase *entity);
+  /// Called when the state of an entity was sent, completes the timing of a command for it.
+  void state_sent_(EntityBase *entity) {
+    if (!this->pending_commands_.empty())
+      this->complete_command_(entity);
+  }
+  void complete_command_(EntityBase *entity);
+#else
+  void command_received_(EntityBase *entity) {}
+  void state_sent_(EntityBase *entity) {}
+#endif
+
   enum class ConnectionState {
     WAITING_FOR_HELLO,
     CONNECTED,
@@ -199,6 +316,8 @@ class APIConnection : public APIServerConnection {
   // Buffer used to encode proto messages
   // Re-use to prevent allocations
   std::vector<uint8_t> proto_write_buffer_;
+  // Buffer received packets are read into, the strings of decoded messages point into it
+  ReadPacketBuffer read_buffer_;
   std::unique_ptr<APIFrameHelper> helper_;
 
   std::string client_info_;
@@ -219,6 +338,33 @@ class APIConnection : public APIServerConnection {
   bool next_close_ = false;
   APIServer *parent_;
   InitialStateIterator initial_state_iterator_;
+  /// Whether the client only subscribed to some entities, the ones in subscribed_entities_.
+  bool filter_states_{false};
+  /// The entities the client subscribed to, sorted by pointer.
+  std::vector<EntityBase *> subscribed_entities_;
+  std::vector<StateLimit> state_limits_;
+  std::vector<DeferredState> deferred_states_;
+  uint32_t deferred_state_count_{0};
+  uint32_t coalesced_state_count_{0};
+#ifdef USE_API_SENSOR_BATCH
+  bool batch_sensor_states_{false};
+  /// Sensors that changed since the last BatchSensorStateResponse, their current state is sent.
+  std::vector<sensor::Sensor *> sensor_batch_;
+  uint32_t sensor_batch_start_{0};
+#endif
+#ifdef USE_API_CONNECTION_STATS
+  struct PendingCommand {
+    EntityBase *entity;
+    uint32_t received_us;
+  };
+  /// Send buffer and command latency counters, the traffic ones are summed up from message_stats_.
+  APIConnectionStats stats_;
+  /// Sorted by message type.
+  std::vector<APIMessageStats> message_stats_;
+  /// Commands whose state update was not sent yet.
+  std::vector<PendingCommand> pending_commands_;
+  uint32_t connected_at_{0};
+#endif
   ListEntitiesIterator list_entities_iterator_;
   int state_subs_at_ = -1;
 };
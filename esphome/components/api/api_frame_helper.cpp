@@ -5,7 +5,9 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 #include "proto.h"
+#include <algorithm>
 #include <cstring>
+#include <new>
 
 namespace esphome {
 namespace api {
@@ -20,6 +22,98 @@ bool is_would_block(ssize_t ret) {
   return ret == 0;
 }
 
+bool APITxBuffer::allocate_() {
+  if (this->data_ == nullptr)
+    this->data_.reset(new (std::nothrow) uint8_t[this->capacity_]);  // NOLINT(cppcoreguidelines-owning-memory)
+  return this->data_ != nullptr;
+}
+void APITxBuffer::copy_in_(const uint8_t *data, size_t len) {
+  size_t tail = (this->head_ + this->size_) % this->capacity_;
+  size_t first = std::min(len, this->capacity_ - tail);
+  memcpy(&this->data_[tail], data, first);
+  memcpy(&this->data_[0], data + first, len - first);
+  this->size_ += len;
+}
+bool APITxBuffer::push(const uint8_t *data, size_t len) {
+  if (len > this->free())
+    return false;
+  if (len == 0)
+    return true;
+  if (!this->allocate_())
+    return false;
+  this->copy_in_(data, len);
+  this->high_water_mark_ = std::max(this->high_water_mark_, this->size_);
+  return true;
+}
+bool APITxBuffer::push_rest(const struct iovec *iov, int iovcnt, size_t skip) {
+  size_t len = 0;
+  for (int i = 0; i < iovcnt; i++)
+    len += iov[i].iov_len;
+  len -= std::min(len, skip);
+  if (len == 0)
+    return true;
+  if (!this->allocate_())
+    return false;
+  if (len > this->free()) {
+    // Buffer all of it in the overflow, it moves into the ring as the ring is written
+    if (this->overflow_ != nullptr)
+      return false;
+    this->overflow_.reset(new (std::nothrow) uint8_t[len]);  // NOLINT(cppcoreguidelines-owning-memory)
+    if (this->overflow_ == nullptr)
+      return false;
+    this->overflow_size_ = len;
+    this->overflow_pos_ = 0;
+    size_t pos = 0;
+    for (int i = 0; i < iovcnt; i++) {
+      size_t offset = std::min(skip, iov[i].iov_len);
+      skip -= offset;
+      memcpy(&this->overflow_[pos], reinterpret_cast<uint8_t *>(iov[i].iov_base) + offset, iov[i].iov_len - offset);
+      pos += iov[i].iov_len - offset;
+    }
+    this->high_water_mark_ = std::max(this->high_water_mark_, this->size());
+    this->refill_();
+    return true;
+  }
+  for (int i = 0; i < iovcnt; i++) {
+    size_t offset = std::min(skip, iov[i].iov_len);
+    skip -= offset;
+    if (!this->push(reinterpret_cast<uint8_t *>(iov[i].iov_base) + offset, iov[i].iov_len - offset))
+      return false;
+  }
+  return true;
+}
+int APITxBuffer::get_spans(struct iovec *iov) const {
+  if (this->size_ == 0)
+    return 0;
+  size_t first = std::min(this->size_, this->capacity_ - this->head_);
+  iov[0].iov_base = &this->data_[this->head_];
+  iov[0].iov_len = first;
+  if (first == this->size_)
+    return 1;
+  iov[1].iov_base = &this->data_[0];
+  iov[1].iov_len = this->size_ - first;
+  return 2;
+}
+void APITxBuffer::consume(size_t len) {
+  len = std::min(len, this->size_);
+  this->size_ -= len;
+  // Start over at the beginning once empty, so the next data is more likely to be contiguous
+  this->head_ = this->size_ == 0 ? 0 : (this->head_ + len) % this->capacity_;
+  this->refill_();
+}
+void APITxBuffer::refill_() {
+  if (this->overflow_ == nullptr)
+    return;
+  size_t len = std::min(this->capacity_ - this->size_, this->overflow_size_ - this->overflow_pos_);
+  this->copy_in_(&this->overflow_[this->overflow_pos_], len);
+  this->overflow_pos_ += len;
+  if (this->overflow_pos_ == this->overflow_size_) {
+    this->overflow_.reset();
+    this->overflow_size_ = 0;
+    this->overflow_pos_ = 0;
+  }
+}
+
 const char *api_error_to_str(APIError err) {
   // not using switch to ensure compiler doesn't try to build a big table out of it
   if (err == APIError::OK) {
@@ -256,9 +350,9 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
 #ifdef HELPER_LOG_PACKETS
   ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
-  // consume msg
-  rx_buf_ = {};
+  // consume msg, keeping the storage frame->msg brought along for the next frame
+  frame->msg.swap(rx_buf_);
+  rx_buf_.clear();
   rx_buf_len_ = 0;
   rx_header_buf_len_ = 0;
   return APIError::OK;
@@ -294,7 +388,36 @@ APIError APINoiseFrameHelper::state_action_() {
     }
     if (aerr != APIError::OK)
       return aerr;
+#ifdef USE_API_NOISE_RESUMPTION
+    // Client hello, ignored by older versions, empty for a full handshake without a ticket, or
+    // uint8_t type;  0x01: full handshake, the server sends a ticket to resume the session with later
+    //
+    // uint8_t type;  0x02: resume the session of a ticket, falls back to a full handshake if it is unknown
+    // uint8_t ticket_id[16];  from the last handshake message of an earlier session
+    // uint8_t client_nonce[16];  random
+    //
+    // A ticket is the 16 byte payload of the server's last handshake message. Its secret is
+    // HKDF-SHA256(chaining key = PSK, input = handshake hash), the first 32 byte output. A resumed session uses the
+    // keys HKDF-SHA256(chaining key = secret, input = client_nonce || server_nonce), the first 32 byte output
+    // encrypts client to server, the second server to client, both with ChaChaPoly starting at nonce 0. A ticket can
+    // only be used once and expires after an hour, a resumed session doesn't issue a new one.
+    if (!frame.msg.empty() && frame.msg[0] == 0x01) {
+      ticket_requested_ = true;
+    } else if (frame.msg.size() == 1 + 2 * API_NOISE_TICKET_ID_SIZE && frame.msg[0] == 0x02) {
+      ticket_requested_ = true;
+      resuming_ = ctx_->take_ticket(&frame.msg[1], ticket_secret_.data());
+      std::copy_n(&frame.msg[1 + API_NOISE_TICKET_ID_SIZE], API_NOISE_TICKET_ID_SIZE, client_nonce_.begin());
+      if (resuming_ && !random_bytes(server_nonce_.data(), server_nonce_.size())) {
+        state_ = State::FAILED;
+        HELPER_LOG("Could not generate nonce");
+        return APIError::HANDSHAKESTATE_SETUP_FAILED;
+      }
+      if (!resuming_)
+        HELPER_LOG("Unknown or expired ticket, doing a full handshake");
+    }
+#else
     // ignore contents, may be used in future for flags
+#endif
     prologue_.push_back((uint8_t) (frame.msg.size() >> 8));
     prologue_.push_back((uint8_t) frame.msg.size());
     prologue_.insert(prologue_.end(), frame.msg.begin(), frame.msg.end());
@@ -303,19 +426,33 @@ APIError APINoiseFrameHelper::state_action_() {
   }
   if (state_ == State::SERVER_HELLO) {
     // send server hello
+    // uint8_t proto;  chosen proto: 0x01 for Noise_NNpsk0_25519_ChaChaPoly_SHA256, 0x02 for a resumed session
+    // char node_name[];  terminated by null byte
+    // uint8_t server_nonce[16];  only for a resumed session, data frames follow directly
     std::vector<uint8_t> msg;
-    // chosen proto
+#ifdef USE_API_NOISE_RESUMPTION
+    msg.push_back(resuming_ ? 0x02 : 0x01);
+#else
     msg.push_back(0x01);
+#endif
 
-    // node name, terminated by null byte
     const std::string &name = App.get_name();
     const uint8_t *name_ptr = reinterpret_cast<const uint8_t *>(name.c_str());
     msg.insert(msg.end(), name_ptr, name_ptr + name.size() + 1);
+#ifdef USE_API_NOISE_RESUMPTION
+    if (resuming_)
+      msg.insert(msg.end(), server_nonce_.begin(), server_nonce_.end());
+#endif
 
     aerr = write_frame_(msg.data(), msg.size());
     if (aerr != APIError::OK)
       return aerr;
 
+#ifdef USE_API_NOISE_RESUMPTION
+    if (resuming_)
+      return resume_session_();
+#endif
+
     // start handshake
     aerr = init_handshake_();
     if (aerr != APIError::OK)
@@ -368,12 +505,27 @@ APIError APINoiseFrameHelper::state_action_() {
       if (aerr != APIError::OK)
         return aerr;
     } else if (action == NOISE_ACTION_WRITE_MESSAGE) {
-      uint8_t buffer[65];
+      // error byte, ephemeral key, payload and its MAC
+      uint8_t buffer[1 + 32 + 16 + 16];
       NoiseBuffer mbuf;
       noise_buffer_init(mbuf);
       noise_buffer_set_output(mbuf, buffer + 1, sizeof(buffer) - 1);
 
+#ifdef USE_API_NOISE_RESUMPTION
+      // The ticket id is the payload of the last handshake message, so it is sent encrypted
+      NoiseBuffer payload;
+      noise_buffer_init(payload);
+      NoiseBuffer *payload_ptr = nullptr;
+      if (ticket_requested_ && random_bytes(ticket_id_.data(), ticket_id_.size())) {
+        noise_buffer_set_input(payload, ticket_id_.data(), ticket_id_.size());
+        payload_ptr = &payload;
+      } else {
+        ticket_requested_ = false;
+      }
+      err = noise_handshakestate_write_message(handshake_, &mbuf, payload_ptr);
+#else
       err = noise_handshakestate_write_message(handshake_, &mbuf, nullptr);
+#endif
       if (err != 0) {
         state_ = State::FAILED;
         HELPER_LOG("noise_handshakestate_write_message failed: %s", noise_err_to_str(err).c_str());
@@ -426,9 +578,13 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   }
 
   ParsedFrame frame;
+  // Reuse the storage of the previous packet, the decoded messages only reference it until they are handled
+  frame.msg.swap(buffer->container);
   aerr = try_read_frame_(&frame);
-  if (aerr != APIError::OK)
+  if (aerr != APIError::OK) {
+    buffer->container.swap(frame.msg);
     return aerr;
+  }
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
@@ -482,62 +638,83 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   size_t padding = 0;
   size_t msg_len = 4 + payload_len + padding;
   size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
+  if (!batching_ && !tx_buf_.empty()) {
+    // Check for room before encrypting, a frame that was encrypted must be sent to keep the nonces in sync
+    aerr = try_send_tx_buf_();
+    if (aerr != APIError::OK)
+      return aerr;
+    if (!tx_buf_.empty() && tx_buf_.free() < frame_len)
+      return APIError::WOULD_BLOCK;
   }
-
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  // Encrypt in place in the frame: directly at the end of the batch, or in a buffer reused for every packet
+  std::vector<uint8_t> &buf = batching_ ? batch_buf_ : frame_buf_;
+  const size_t frame_start = batching_ ? batch_buf_.size() : 0;
+  buf.resize(frame_start + frame_len);
+  uint8_t *frame = &buf[frame_start];
+
+  frame[0] = 0x01;  // indicator
+  // frame[1], frame[2] to be set later
   const uint8_t msg_offset = 3;
   const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
+  frame[msg_offset + 0] = (uint8_t) (type >> 8);  // type
+  frame[msg_offset + 1] = (uint8_t) type;
+  frame[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
+  frame[msg_offset + 3] = (uint8_t) payload_len;
   // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
+  std::copy(payload, payload + payload_len, &frame[payload_offset]);
   // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  std::fill(&frame[payload_offset + payload_len], &frame[frame_len], 0);
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, &frame[msg_offset], msg_len, frame_len - msg_offset);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
+    buf.resize(frame_start);
     state_ = State::FAILED;
     HELPER_LOG("noise_cipherstate_encrypt failed: %s", noise_err_to_str(err).c_str());
     return APIError::CIPHERSTATE_ENCRYPT_FAILED;
   }
 
   size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t) (mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  frame[1] = (uint8_t) (mbuf.size >> 8);
+  frame[2] = (uint8_t) mbuf.size;
+  buf.resize(frame_start + total_len);
+  if (batching_)
+    return APIError::OK;
 
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
+  iov.iov_base = frame;
   iov.iov_len = total_len;
 
   // write raw to not have two packets sent if NAGLE disabled
   return write_raw_(&iov, 1);
 }
+APIError APINoiseFrameHelper::end_batch() {
+  batching_ = false;
+  if (batch_buf_.empty())
+    return APIError::OK;
+  struct iovec iov;
+  iov.iov_base = batch_buf_.data();
+  iov.iov_len = batch_buf_.size();
+  APIError err = write_raw_(&iov, 1);
+  batch_buf_.clear();
+  return err;
+}
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
-    if (sent == -1) {
-      if (errno == EWOULDBLOCK || errno == EAGAIN)
-        break;
+    struct iovec iov[2];
+    int iovcnt = tx_buf_.get_spans(iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
+    if (is_would_block(sent)) {
+      break;
+    } else if (sent == -1) {
       state_ = State::FAILED;
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
-    } else if (sent == 0) {
-      break;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    tx_buf_.consume(sent);
   }
 
   return APIError::OK;
@@ -546,12 +723,21 @@ APIError APINoiseFrameHelper::try_send_tx_buf_() {
  *
  * @param data The data to write
  * @param len The length of data
+ * @return WOULD_BLOCK if data is already buffered and there is no room for this data
  */
 APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
     return APIError::OK;
   APIError aerr;
 
+  if (batching_) {
+    for (int i = 0; i < iovcnt; i++) {
+      batch_buf_.insert(batch_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
+                        reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+    }
+    return APIError::OK;
+  }
+
   size_t total_write_len = 0;
   for (int i = 0; i < iovcnt; i++) {
 #ifdef HELPER_LOG_PACKETS
@@ -568,43 +754,31 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
       return aerr;
   }
 
-  if (!tx_buf_.empty()) {
-    // tx buf not empty, can't write now because then stream would be inconsistent
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+  ssize_t sent = 0;
+  if (tx_buf_.empty()) {
+    sent = socket_->writev(iov, iovcnt);
+    if (is_would_block(sent)) {
+      sent = 0;
+    } else if (sent == -1) {
+      // an error occurred
+      state_ = State::FAILED;
+      HELPER_LOG("Socket write failed with errno %d", errno);
+      return APIError::SOCKET_WRITE_FAILED;
+    } else if ((size_t) sent == total_write_len) {
+      // fully sent
+      return APIError::OK;
     }
-    return APIError::OK;
+  } else if (tx_buf_.free() < total_write_len) {
+    // tx buf not empty, can't write now because then stream would be inconsistent
+    return APIError::WOULD_BLOCK;
   }
 
-  ssize_t sent = socket_->writev(iov, iovcnt);
-  if (is_would_block(sent)) {
-    // operation would block, add buffer to tx_buf
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
-    return APIError::OK;
-  } else if (sent == -1) {
-    // an error occurred
+  // add the part that wasn't sent to tx_buf, all of it as the rest of the frame may already be written
+  if (!tx_buf_.push_rest(iov, iovcnt, sent)) {
     state_ = State::FAILED;
-    HELPER_LOG("Socket write failed with errno %d", errno);
-    return APIError::SOCKET_WRITE_FAILED;
-  } else if ((size_t) sent != total_write_len) {
-    // partially sent, add end to tx_buf
-    size_t to_consume = sent;
-    for (int i = 0; i < iovcnt; i++) {
-      if (to_consume >= iov[i].iov_len) {
-        to_consume -= iov[i].iov_len;
-      } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-        to_consume = 0;
-      }
-    }
-    return APIError::OK;
+    HELPER_LOG("Out of memory buffering %zu bytes", total_write_len - sent);
+    return APIError::OUT_OF_MEMORY;
   }
-  // fully sent
   return APIError::OK;
 }
 APIError APINoiseFrameHelper::write_frame_(const uint8_t *data, size_t len) {
@@ -686,6 +860,23 @@ APIError APINoiseFrameHelper::check_handshake_finished_() {
     HELPER_LOG("Bad action for handshake: %d", action);
     return APIError::HANDSHAKESTATE_BAD_STATE;
   }
+#ifdef USE_API_NOISE_RESUMPTION
+  if (ticket_requested_) {
+    // Bind the ticket to this handshake and the PSK, a resumed session derives its keys from this secret
+    uint8_t handshake_hash[32];
+    NoiseHashState *hash = nullptr;
+    if (noise_handshakestate_get_handshake_hash(handshake_, handshake_hash, sizeof(handshake_hash)) == 0 &&
+        noise_hashstate_new_by_id(&hash, NOISE_HASH_SHA256) == 0) {
+      const auto &psk = ctx_->get_psk();
+      uint8_t unused[32];
+      noise_hashstate_hkdf(hash, psk.data(), psk.size(), handshake_hash, sizeof(handshake_hash), ticket_secret_.data(),
+                           ticket_secret_.size(), unused, sizeof(unused));
+      ctx_->add_ticket(ticket_id_.data(), ticket_secret_.data());
+    }
+    if (hash != nullptr)
+      noise_hashstate_free(hash);
+  }
+#endif
   int err = noise_handshakestate_split(handshake_, &send_cipher_, &recv_cipher_);
   if (err != 0) {
     state_ = State::FAILED;
@@ -699,6 +890,42 @@ APIError APINoiseFrameHelper::check_handshake_finished_() {
   state_ = State::DATA;
   return APIError::OK;
 }
+#ifdef USE_API_NOISE_RESUMPTION
+APIError APINoiseFrameHelper::resume_session_() {
+  uint8_t nonces[2 * API_NOISE_TICKET_ID_SIZE];
+  std::copy(client_nonce_.begin(), client_nonce_.end(), nonces);
+  std::copy(server_nonce_.begin(), server_nonce_.end(), nonces + API_NOISE_TICKET_ID_SIZE);
+  uint8_t client_key[32];
+  uint8_t server_key[32];
+  NoiseHashState *hash = nullptr;
+  int err = noise_hashstate_new_by_id(&hash, NOISE_HASH_SHA256);
+  if (err == 0) {
+    noise_hashstate_hkdf(hash, ticket_secret_.data(), ticket_secret_.size(), nonces, sizeof(nonces), client_key,
+                         sizeof(client_key), server_key, sizeof(server_key));
+    noise_hashstate_free(hash);
+  }
+  if (err == 0)
+    err = noise_cipherstate_new_by_id(&recv_cipher_, NOISE_CIPHER_CHACHAPOLY);
+  if (err == 0)
+    err = noise_cipherstate_new_by_id(&send_cipher_, NOISE_CIPHER_CHACHAPOLY);
+  if (err == 0)
+    err = noise_cipherstate_init_key(recv_cipher_, client_key, sizeof(client_key));
+  if (err == 0)
+    err = noise_cipherstate_init_key(send_cipher_, server_key, sizeof(server_key));
+  memset(ticket_secret_.data(), 0, ticket_secret_.size());
+  memset(client_key, 0, sizeof(client_key));
+  memset(server_key, 0, sizeof(server_key));
+  if (err != 0) {
+    state_ = State::FAILED;
+    HELPER_LOG("Resuming session failed: %s", noise_err_to_str(err).c_str());
+    return APIError::HANDSHAKESTATE_SPLIT_FAILED;
+  }
+
+  HELPER_LOG("Session resumed!");
+  state_ = State::DATA;
+  return APIError::OK;
+}
+#endif
 
 APINoiseFrameHelper::~APINoiseFrameHelper() {
   if (handshake_ != nullptr) {
@@ -875,9 +1102,9 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
 #ifdef HELPER_LOG_PACKETS
   ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
-  // consume msg
-  rx_buf_ = {};
+  // consume msg, keeping the storage frame->msg brought along for the next frame
+  frame->msg.swap(rx_buf_);
+  rx_buf_.clear();
   rx_buf_len_ = 0;
   rx_header_buf_.clear();
   rx_header_parsed_ = false;
@@ -892,9 +1119,13 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   }
 
   ParsedFrame frame;
+  // Reuse the storage of the previous packet, the decoded messages only reference it until they are handled
+  frame.msg.swap(buffer->container);
   aerr = try_read_frame_(&frame);
-  if (aerr != APIError::OK)
+  if (aerr != APIError::OK) {
+    buffer->container.swap(frame.msg);
     return aerr;
+  }
 
   buffer->container = std::move(frame.msg);
   buffer->data_offset = 0;
@@ -924,10 +1155,23 @@ APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *pay
 
   return write_raw_(iov, 2);
 }
+APIError APIPlaintextFrameHelper::end_batch() {
+  batching_ = false;
+  if (batch_buf_.empty())
+    return APIError::OK;
+  struct iovec iov;
+  iov.iov_base = batch_buf_.data();
+  iov.iov_len = batch_buf_.size();
+  APIError err = write_raw_(&iov, 1);
+  batch_buf_.clear();
+  return err;
+}
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    struct iovec iov[2];
+    int iovcnt = tx_buf_.get_spans(iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
     if (is_would_block(sent)) {
       break;
     } else if (sent == -1) {
@@ -935,9 +1179,7 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    tx_buf_.consume(sent);
   }
 
   return APIError::OK;
@@ -946,12 +1188,21 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
  *
  * @param data The data to write
  * @param len The length of data
+ * @return WOULD_BLOCK if data is already buffered and there is no room for this data
  */
 APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
     return APIError::OK;
   APIError aerr;
 
+  if (batching_) {
+    for (int i = 0; i < iovcnt; i++) {
+      batch_buf_.insert(batch_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
+                        reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+    }
+    return APIError::OK;
+  }
+
   size_t total_write_len = 0;
   for (int i = 0; i < iovcnt; i++) {
 #ifdef HELPER_LOG_PACKETS
@@ -968,43 +1219,31 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
       return aerr;
   }
 
-  if (!tx_buf_.empty()) {
-    // tx buf not empty, can't write now because then stream would be inconsistent
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
+  ssize_t sent = 0;
+  if (tx_buf_.empty()) {
+    sent = socket_->writev(iov, iovcnt);
+    if (is_would_block(sent)) {
+      sent = 0;
+    } else if (sent == -1) {
+      // an error occurred
+      state_ = State::FAILED;
+      HELPER_LOG("Socket write failed with errno %d", errno);
+      return APIError::SOCKET_WRITE_FAILED;
+    } else if ((size_t) sent == total_write_len) {
+      // fully sent
+      return APIError::OK;
     }
-    return APIError::OK;
+  } else if (tx_buf_.free() < total_write_len) {
+    // tx buf not empty, can't write now because then stream would be inconsistent
+    return APIError::WOULD_BLOCK;
   }
 
-  ssize_t sent = socket_->writev(iov, iovcnt);
-  if (is_would_block(sent)) {
-    // operation would block, add buffer to tx_buf
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
-    return APIError::OK;
-  } else if (sent == -1) {
-    // an error occurred
+  // add the part that wasn't sent to tx_buf, all of it as the rest of the frame may already be written
+  if (!tx_buf_.push_rest(iov, iovcnt, sent)) {
     state_ = State::FAILED;
-    HELPER_LOG("Socket write failed with errno %d", errno);
-    return APIError::SOCKET_WRITE_FAILED;
-  } else if ((size_t) sent != total_write_len) {
-    // partially sent, add end to tx_buf
-    size_t to_consume = sent;
-    for (int i = 0; i < iovcnt; i++) {
-      if (to_consume >= iov[i].iov_len) {
-        to_consume -= iov[i].iov_len;
-      } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-        to_consume = 0;
-      }
-    }
-    return APIError::OK;
+    HELPER_LOG("Out of memory buffering %zu bytes", total_write_len - sent);
+    return APIError::OUT_OF_MEMORY;
   }
-  // fully sent
   return APIError::OK;
 }
 
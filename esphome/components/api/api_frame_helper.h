@@ -1,6 +1,8 @@
 #pragma once
+#include <array>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -58,6 +60,53 @@ enum class APIError : int {
 
 const char *api_error_to_str(APIError err);
 
+/** Fixed capacity ring buffer holding the data that could not be written to the socket yet.
+ *
+ * The storage is only allocated once data has to be buffered. The buffered data can be handed to writev() as up to two
+ * contiguous spans, so it is written without being moved or copied again.
+ *
+ * The rest of a frame that was partly written must be buffered whole, or the stream would be corrupted. What doesn't
+ * fit into the ring then goes to an overflow buffer, which moves into the ring as it is written and is freed once
+ * empty. Nothing else fits until then, so the overflow only ever holds the rest of one frame.
+ */
+class APITxBuffer {
+ public:
+  void set_capacity(size_t capacity) { this->capacity_ = capacity; }
+  size_t get_capacity() const { return this->capacity_; }
+  bool empty() const { return this->size() == 0; }
+  size_t size() const { return this->size_ + this->overflow_size_ - this->overflow_pos_; }
+  size_t free() const { return this->overflow_ == nullptr ? this->capacity_ - this->size_ : 0; }
+  /// The most bytes that were buffered at any time.
+  size_t get_high_water_mark() const { return this->high_water_mark_; }
+
+  /// Append data at the end, fails if there isn't enough room for all of it.
+  bool push(const uint8_t *data, size_t len);
+  /// Append the data of iov after its first skip bytes, which were written already, overflowing if needed. Only fails
+  /// if memory can't be allocated.
+  bool push_rest(const struct iovec *iov, int iovcnt, size_t skip);
+  /// Point iov (which must have room for two entries) to the buffered data, returns the number of entries used.
+  int get_spans(struct iovec *iov) const;
+  /// Drop len bytes from the front, after they were written.
+  void consume(size_t len);
+
+ protected:
+  bool allocate_();
+  /// Copy data to the end of the ring, which must have room for it.
+  void copy_in_(const uint8_t *data, size_t len);
+  /// Move as much of the overflow into the ring as fits.
+  void refill_();
+
+  std::unique_ptr<uint8_t[]> data_;
+  size_t capacity_{0};
+  size_t head_{0};
+  size_t size_{0};
+  size_t high_water_mark_{0};
+  std::unique_ptr<uint8_t[]> overflow_;
+  size_t overflow_size_{0};
+  /// Start of the overflow data not moved into the ring yet.
+  size_t overflow_pos_{0};
+};
+
 class APIFrameHelper {
  public:
   virtual ~APIFrameHelper() = default;
@@ -66,6 +115,16 @@ class APIFrameHelper {
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
   virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /// Collect the packets written from now on, to send them all with a single write in end_batch().
+  virtual void begin_batch() = 0;
+  /// Send the packets collected since begin_batch().
+  virtual APIError end_batch() = 0;
+  /// Number of bytes collected since begin_batch().
+  virtual size_t get_batch_size() = 0;
+  /// Limit the data buffered while the socket can't take it, a write that doesn't fit fails.
+  virtual void set_tx_buffer_size(size_t size) = 0;
+  /// The most bytes that were buffered while the socket couldn't take them.
+  virtual size_t get_tx_buffer_high_water_mark() = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
@@ -85,6 +144,11 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  void begin_batch() override { batching_ = true; }
+  APIError end_batch() override;
+  size_t get_batch_size() override { return batch_buf_.size(); }
+  void set_tx_buffer_size(size_t size) override { tx_buf_.set_capacity(size); }
+  size_t get_tx_buffer_high_water_mark() override { return tx_buf_.get_high_water_mark(); }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -107,6 +171,10 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError init_handshake_();
   APIError check_handshake_finished_();
   void send_explicit_handshake_reject_(const std::string &reason);
+#ifdef USE_API_NOISE_RESUMPTION
+  /// Derive the keys of a resumed session from the ticket secret and the nonces of both sides.
+  APIError resume_session_();
+#endif
 
   std::unique_ptr<socket::Socket> socket_;
 
@@ -116,8 +184,22 @@ class APINoiseFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  APITxBuffer tx_buf_;
+  bool batching_ = false;
+  std::vector<uint8_t> batch_buf_;
+  /// Frame packets are encrypted in when not batching, reused to not allocate for every packet.
+  std::vector<uint8_t> frame_buf_;
   std::vector<uint8_t> prologue_;
+#ifdef USE_API_NOISE_RESUMPTION
+  /// Whether the client asked for a ticket to resume the session with later.
+  bool ticket_requested_{false};
+  /// Whether the client resumes a session, skipping the handshake.
+  bool resuming_{false};
+  std::array<uint8_t, API_NOISE_TICKET_ID_SIZE> ticket_id_;
+  std::array<uint8_t, 32> ticket_secret_;
+  std::array<uint8_t, API_NOISE_TICKET_ID_SIZE> client_nonce_;
+  std::array<uint8_t, API_NOISE_TICKET_ID_SIZE> server_nonce_;
+#endif
 
   std::shared_ptr<APINoiseContext> ctx_;
   NoiseHandshakeState *handshake_{nullptr};
@@ -148,6 +230,11 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  void begin_batch() override { batching_ = true; }
+  APIError end_batch() override;
+  size_t get_batch_size() override { return batch_buf_.size(); }
+  void set_tx_buffer_size(size_t size) override { tx_buf_.set_capacity(size); }
+  size_t get_tx_buffer_high_water_mark() override { return tx_buf_.get_high_water_mark(); }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -177,7 +264,9 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  APITxBuffer tx_buf_;
+  bool batching_ = false;
+  std::vector<uint8_t> batch_buf_;
 
   enum class State {
     INITIALIZE = 1,
@@ -0,0 +1,47 @@
+#include "api_noise_context.h"
+
+#ifdef USE_API_NOISE_RESUMPTION
+
+#include "esphome/core/hal.h"
+#include <cstring>
+
+namespace esphome {
+namespace api {
+
+void APINoiseContext::add_ticket(const uint8_t *id, const uint8_t *secret) {
+  const uint32_t now = millis();
+  APINoiseTicket *slot = &this->tickets_[0];
+  for (auto &ticket : this->tickets_) {
+    if (!ticket.valid || now - ticket.created >= API_NOISE_TICKET_LIFETIME) {
+      slot = &ticket;
+      break;
+    }
+    if (now - ticket.created > now - slot->created)
+      slot = &ticket;
+  }
+  memcpy(slot->id.data(), id, slot->id.size());
+  memcpy(slot->secret.data(), secret, slot->secret.size());
+  slot->created = now;
+  slot->valid = true;
+}
+
+bool APINoiseContext::take_ticket(const uint8_t *id, uint8_t *secret) {
+  const uint32_t now = millis();
+  for (auto &ticket : this->tickets_) {
+    if (!ticket.valid || memcmp(ticket.id.data(), id, ticket.id.size()) != 0)
+      continue;
+    ticket.valid = false;
+    if (now - ticket.created >= API_NOISE_TICKET_LIFETIME)
+      return false;
+    memcpy(secret, ticket.secret.data(), ticket.secret.size());
+    // Don't leave the secret in memory once it can't be used anymore
+    memset(ticket.secret.data(), 0, ticket.secret.size());
+    return true;
+  }
+  return false;
+}
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_NOISE_RESUMPTION
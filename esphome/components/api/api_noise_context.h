@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <array>
 #include "esphome/core/defines.h"
@@ -9,13 +10,43 @@ namespace api {
 #ifdef USE_API_NOISE
 using psk_t = std::array<uint8_t, 32>;
 
+#ifdef USE_API_NOISE_RESUMPTION
+/// Size of the id of a session resumption ticket, and of the nonces of a resumed session.
+static const size_t API_NOISE_TICKET_ID_SIZE = 16;
+/// Number of tickets kept, the oldest one is replaced by a new one.
+static const size_t API_NOISE_MAX_TICKETS = 4;
+/// A ticket can only be used for this long after the handshake it was issued in.
+static const uint32_t API_NOISE_TICKET_LIFETIME = 60 * 60 * 1000;
+
+struct APINoiseTicket {
+  std::array<uint8_t, API_NOISE_TICKET_ID_SIZE> id;
+  /// Secret derived from the handshake the ticket was issued in, the keys of resumed sessions are derived from it.
+  std::array<uint8_t, 32> secret;
+  uint32_t created;
+  bool valid{false};
+};
+#endif  // USE_API_NOISE_RESUMPTION
+
 class APINoiseContext {
  public:
   void set_psk(psk_t psk) { psk_ = psk; }
   const psk_t &get_psk() const { return psk_; }
 
+#ifdef USE_API_NOISE_RESUMPTION
+  /// Remember the secret of a ticket issued to a client.
+  void add_ticket(const uint8_t *id, const uint8_t *secret);
+  /** Look up a ticket a client wants to resume a session with.
+   *
+   * A ticket can only be used once, it is removed from the store. Returns false if it is unknown or expired.
+   */
+  bool take_ticket(const uint8_t *id, uint8_t *secret);
+#endif
+
  protected:
   psk_t psk_;
+#ifdef USE_API_NOISE_RESUMPTION
+  std::array<APINoiseTicket, API_NOISE_MAX_TICKETS> tickets_{};
+#endif
 };
 #endif  // USE_API_NOISE
 
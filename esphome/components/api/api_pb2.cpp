@@ -501,7 +501,7 @@ bool HelloRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool HelloRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->client_info = value.as_string();
+      this->client_info = value.as_string_ref();
       return true;
     }
     default:
@@ -513,12 +513,17 @@ void HelloRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->api_version_major);
   buffer.encode_uint32(3, this->api_version_minor);
 }
+void HelloRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->client_info);
+  ProtoSize::add_uint32_field(total_size, 1, this->api_version_major);
+  ProtoSize::add_uint32_field(total_size, 1, this->api_version_minor);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("HelloRequest {\n");
   out.append("  client_info: ");
-  out.append("'").append(this->client_info).append("'");
+  out.append("'").append(this->client_info.c_str(), this->client_info.size()).append("'");
   out.append("\n");
 
   out.append("  api_version_major: ");
@@ -567,6 +572,12 @@ void HelloResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->server_info);
   buffer.encode_string(4, this->name);
 }
+void HelloResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->api_version_major);
+  ProtoSize::add_uint32_field(total_size, 1, this->api_version_minor);
+  ProtoSize::add_string_field(total_size, 1, this->server_info);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -594,7 +605,7 @@ void HelloResponse::dump_to(std::string &out) const {
 bool ConnectRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->password = value.as_string();
+      this->password = value.as_string_ref();
       return true;
     }
     default:
@@ -602,12 +613,15 @@ bool ConnectRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value
   }
 }
 void ConnectRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->password); }
+void ConnectRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("ConnectRequest {\n");
   out.append("  password: ");
-  out.append("'").append(this->password).append("'");
+  out.append("'").append(this->password.c_str(), this->password.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -623,6 +637,9 @@ bool ConnectResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   }
 }
 void ConnectResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->invalid_password); }
+void ConnectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->invalid_password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -634,22 +651,27 @@ void ConnectResponse::dump_to(std::string &out) const {
 }
 #endif
 void DisconnectRequest::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectRequest::dump_to(std::string &out) const { out.append("DisconnectRequest {}"); }
 #endif
 void DisconnectResponse::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectResponse::dump_to(std::string &out) const { out.append("DisconnectResponse {}"); }
 #endif
 void PingRequest::encode(ProtoWriteBuffer buffer) const {}
+void PingRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingRequest::dump_to(std::string &out) const { out.append("PingRequest {}"); }
 #endif
 void PingResponse::encode(ProtoWriteBuffer buffer) const {}
+void PingResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingResponse::dump_to(std::string &out) const { out.append("PingResponse {}"); }
 #endif
 void DeviceInfoRequest::encode(ProtoWriteBuffer buffer) const {}
+void DeviceInfoRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoRequest::dump_to(std::string &out) const { out.append("DeviceInfoRequest {}"); }
 #endif
@@ -742,6 +764,23 @@ void DeviceInfoResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(13, this->friendly_name);
   buffer.encode_uint32(14, this->voice_assistant_version);
 }
+void DeviceInfoResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->uses_password);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->mac_address);
+  ProtoSize::add_string_field(total_size, 1, this->esphome_version);
+  ProtoSize::add_string_field(total_size, 1, this->compilation_time);
+  ProtoSize::add_string_field(total_size, 1, this->model);
+  ProtoSize::add_bool_field(total_size, 1, this->has_deep_sleep);
+  ProtoSize::add_string_field(total_size, 1, this->project_name);
+  ProtoSize::add_string_field(total_size, 1, this->project_version);
+  ProtoSize::add_uint32_field(total_size, 1, this->webserver_port);
+  ProtoSize::add_uint32_field(total_size, 1, this->legacy_bluetooth_proxy_version);
+  ProtoSize::add_uint32_field(total_size, 1, this->bluetooth_proxy_feature_flags);
+  ProtoSize::add_string_field(total_size, 1, this->manufacturer);
+  ProtoSize::add_string_field(total_size, 1, this->friendly_name);
+  ProtoSize::add_uint32_field(total_size, 1, this->voice_assistant_version);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -813,16 +852,208 @@ void DeviceInfoResponse::dump_to(std::string &out) const {
 }
 #endif
 void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesRequest::dump_to(std::string &out) const { out.append("ListEntitiesRequest {}"); }
 #endif
 void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesDoneResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
 #endif
-void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+bool SubscribeStatesEntity::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 2: {
+      this->domain = value.as_string_ref();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SubscribeStatesEntity::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->key = value.as_fixed32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesEntity::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_fixed32(1, this->key);
+  buffer.encode_string(2, this->domain);
+}
+void SubscribeStatesEntity::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->domain);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SubscribeStatesEntity::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SubscribeStatesEntity {\n");
+  out.append("  key: ");
+  sprintf(buffer, "%u", this->key);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  domain: ");
+  out.append("'").append(this->domain.c_str(), this->domain.size()).append("'");
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SubscribeStatesLimit::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->min_interval = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SubscribeStatesLimit::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 4: {
+      this->domain = value.as_string_ref();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SubscribeStatesLimit::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->key = value.as_fixed32();
+      return true;
+    }
+    case 3: {
+      this->deadband = value.as_float();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesLimit::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_fixed32(1, this->key);
+  buffer.encode_string(4, this->domain);
+  buffer.encode_uint32(2, this->min_interval);
+  buffer.encode_float(3, this->deadband);
+}
+void SubscribeStatesLimit::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->domain);
+  ProtoSize::add_uint32_field(total_size, 1, this->min_interval);
+  ProtoSize::add_float_field(total_size, 1, this->deadband);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void SubscribeStatesLimit::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SubscribeStatesLimit {\n");
+  out.append("  key: ");
+  sprintf(buffer, "%u", this->key);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  domain: ");
+  out.append("'").append(this->domain.c_str(), this->domain.size()).append("'");
+  out.append("\n");
+
+  out.append("  min_interval: ");
+  sprintf(buffer, "%u", this->min_interval);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  deadband: ");
+  sprintf(buffer, "%g", this->deadband);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool SubscribeStatesRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->batch_sensor_states = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool SubscribeStatesRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 5: {
+      this->entities.push_back(value.as_message<SubscribeStatesEntity>());
+      return true;
+    }
+    case 3: {
+      this->domains.push_back(value.as_string());
+      return true;
+    }
+    case 4: {
+      this->limits.push_back(value.as_message<SubscribeStatesLimit>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_bool(1, this->batch_sensor_states);
+  for (auto &it : this->entities) {
+    buffer.encode_message<SubscribeStatesEntity>(5, it, true);
+  }
+  for (auto &it : this->domains) {
+    buffer.encode_string(3, it, true);
+  }
+  for (auto &it : this->limits) {
+    buffer.encode_message<SubscribeStatesLimit>(4, it, true);
+  }
+}
+void SubscribeStatesRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->batch_sensor_states);
+  for (auto &it : this->entities) {
+    ProtoSize::add_message_field<SubscribeStatesEntity>(total_size, 1, it, true);
+  }
+  for (auto &it : this->domains) {
+    ProtoSize::add_string_field(total_size, 1, it, true);
+  }
+  for (auto &it : this->limits) {
+    ProtoSize::add_message_field<SubscribeStatesLimit>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
-void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
+void SubscribeStatesRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("SubscribeStatesRequest {\n");
+  out.append("  batch_sensor_states: ");
+  out.append(YESNO(this->batch_sensor_states));
+  out.append("\n");
+
+  for (const auto &it : this->entities) {
+    out.append("  entities: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+
+  for (const auto &it : this->domains) {
+    out.append("  domains: ");
+    out.append("'").append(it).append("'");
+    out.append("\n");
+  }
+
+  for (const auto &it : this->limits) {
+    out.append("  limits: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
 #endif
 bool ListEntitiesBinarySensorResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
@@ -889,6 +1120,17 @@ void ListEntitiesBinarySensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(8, this->icon);
   buffer.encode_enum<enums::EntityCategory>(9, this->entity_category);
 }
+void ListEntitiesBinarySensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->device_class);
+  ProtoSize::add_bool_field(total_size, 1, this->is_status_binary_sensor);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesBinarySensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -961,6 +1203,11 @@ void BinarySensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void BinarySensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BinarySensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1060,6 +1307,20 @@ void ListEntitiesCoverResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(11, this->entity_category);
   buffer.encode_bool(12, this->supports_stop);
 }
+void ListEntitiesCoverResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 1, this->assumed_state);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_position);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_tilt);
+  ProtoSize::add_string_field(total_size, 1, this->device_class);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCoverResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1154,6 +1415,13 @@ void CoverStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(4, this->tilt);
   buffer.encode_enum<enums::CoverOperation>(5, this->current_operation);
 }
+void CoverStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::LegacyCoverState>(total_size, 1, this->legacy_state);
+  ProtoSize::add_float_field(total_size, 1, this->position);
+  ProtoSize::add_float_field(total_size, 1, this->tilt);
+  ProtoSize::add_enum_field<enums::CoverOperation>(total_size, 1, this->current_operation);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1237,6 +1505,16 @@ void CoverCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(7, this->tilt);
   buffer.encode_bool(8, this->stop);
 }
+void CoverCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->has_legacy_command);
+  ProtoSize::add_enum_field<enums::LegacyCoverCommand>(total_size, 1, this->legacy_command);
+  ProtoSize::add_bool_field(total_size, 1, this->has_position);
+  ProtoSize::add_float_field(total_size, 1, this->position);
+  ProtoSize::add_bool_field(total_size, 1, this->has_tilt);
+  ProtoSize::add_float_field(total_size, 1, this->tilt);
+  ProtoSize::add_bool_field(total_size, 1, this->stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1353,6 +1631,19 @@ void ListEntitiesFanResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(10, this->icon);
   buffer.encode_enum<enums::EntityCategory>(11, this->entity_category);
 }
+void ListEntitiesFanResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_oscillation);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_speed);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_direction);
+  ProtoSize::add_int32_field(total_size, 1, this->supported_speed_count);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesFanResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1449,6 +1740,14 @@ void FanStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::FanDirection>(5, this->direction);
   buffer.encode_int32(6, this->speed_level);
 }
+void FanStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->oscillating);
+  ProtoSize::add_enum_field<enums::FanSpeed>(total_size, 1, this->speed);
+  ProtoSize::add_enum_field<enums::FanDirection>(total_size, 1, this->direction);
+  ProtoSize::add_int32_field(total_size, 1, this->speed_level);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1550,6 +1849,19 @@ void FanCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(10, this->has_speed_level);
   buffer.encode_int32(11, this->speed_level);
 }
+void FanCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->has_state);
+  ProtoSize::add_bool_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->has_speed);
+  ProtoSize::add_enum_field<enums::FanSpeed>(total_size, 1, this->speed);
+  ProtoSize::add_bool_field(total_size, 1, this->has_oscillating);
+  ProtoSize::add_bool_field(total_size, 1, this->oscillating);
+  ProtoSize::add_bool_field(total_size, 1, this->has_direction);
+  ProtoSize::add_enum_field<enums::FanDirection>(total_size, 1, this->direction);
+  ProtoSize::add_bool_field(total_size, 1, this->has_speed_level);
+  ProtoSize::add_int32_field(total_size, 1, this->speed_level);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1701,6 +2013,27 @@ void ListEntitiesLightResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(14, this->icon);
   buffer.encode_enum<enums::EntityCategory>(15, this->entity_category);
 }
+void ListEntitiesLightResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  for (auto &it : this->supported_color_modes) {
+    ProtoSize::add_enum_field<enums::ColorMode>(total_size, 1, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 1, this->legacy_supports_brightness);
+  ProtoSize::add_bool_field(total_size, 1, this->legacy_supports_rgb);
+  ProtoSize::add_bool_field(total_size, 1, this->legacy_supports_white_value);
+  ProtoSize::add_bool_field(total_size, 1, this->legacy_supports_color_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->min_mireds);
+  ProtoSize::add_float_field(total_size, 1, this->max_mireds);
+  for (auto &it : this->effects) {
+    ProtoSize::add_string_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLightResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1859,6 +2192,21 @@ void LightStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(13, this->warm_white);
   buffer.encode_string(9, this->effect);
 }
+void LightStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->state);
+  ProtoSize::add_float_field(total_size, 1, this->brightness);
+  ProtoSize::add_enum_field<enums::ColorMode>(total_size, 1, this->color_mode);
+  ProtoSize::add_float_field(total_size, 1, this->color_brightness);
+  ProtoSize::add_float_field(total_size, 1, this->red);
+  ProtoSize::add_float_field(total_size, 1, this->green);
+  ProtoSize::add_float_field(total_size, 1, this->blue);
+  ProtoSize::add_float_field(total_size, 1, this->white);
+  ProtoSize::add_float_field(total_size, 1, this->color_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->cold_white);
+  ProtoSize::add_float_field(total_size, 1, this->warm_white);
+  ProtoSize::add_string_field(total_size, 1, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2000,7 +2348,7 @@ bool LightCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool LightCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 19: {
-      this->effect = value.as_string();
+      this->effect = value.as_string_ref();
       return true;
     }
     default:
@@ -2082,6 +2430,35 @@ void LightCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(18, this->has_effect);
   buffer.encode_string(19, this->effect);
 }
+void LightCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->has_state);
+  ProtoSize::add_bool_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->has_brightness);
+  ProtoSize::add_float_field(total_size, 1, this->brightness);
+  ProtoSize::add_bool_field(total_size, 2, this->has_color_mode);
+  ProtoSize::add_enum_field<enums::ColorMode>(total_size, 2, this->color_mode);
+  ProtoSize::add_bool_field(total_size, 2, this->has_color_brightness);
+  ProtoSize::add_float_field(total_size, 2, this->color_brightness);
+  ProtoSize::add_bool_field(total_size, 1, this->has_rgb);
+  ProtoSize::add_float_field(total_size, 1, this->red);
+  ProtoSize::add_float_field(total_size, 1, this->green);
+  ProtoSize::add_float_field(total_size, 1, this->blue);
+  ProtoSize::add_bool_field(total_size, 1, this->has_white);
+  ProtoSize::add_float_field(total_size, 1, this->white);
+  ProtoSize::add_bool_field(total_size, 1, this->has_color_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->color_temperature);
+  ProtoSize::add_bool_field(total_size, 2, this->has_cold_white);
+  ProtoSize::add_float_field(total_size, 2, this->cold_white);
+  ProtoSize::add_bool_field(total_size, 2, this->has_warm_white);
+  ProtoSize::add_float_field(total_size, 2, this->warm_white);
+  ProtoSize::add_bool_field(total_size, 1, this->has_transition_length);
+  ProtoSize::add_uint32_field(total_size, 1, this->transition_length);
+  ProtoSize::add_bool_field(total_size, 2, this->has_flash_length);
+  ProtoSize::add_uint32_field(total_size, 2, this->flash_length);
+  ProtoSize::add_bool_field(total_size, 2, this->has_effect);
+  ProtoSize::add_string_field(total_size, 2, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2203,7 +2580,7 @@ void LightCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  effect: ");
-  out.append("'").append(this->effect).append("'");
+  out.append("'").append(this->effect.c_str(), this->effect.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -2293,6 +2670,21 @@ void ListEntitiesSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(12, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(13, this->entity_category);
 }
+void ListEntitiesSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_string_field(total_size, 1, this->unit_of_measurement);
+  ProtoSize::add_int32_field(total_size, 1, this->accuracy_decimals);
+  ProtoSize::add_bool_field(total_size, 1, this->force_update);
+  ProtoSize::add_string_field(total_size, 1, this->device_class);
+  ProtoSize::add_enum_field<enums::SensorStateClass>(total_size, 1, this->state_class);
+  ProtoSize::add_enum_field<enums::SensorLastResetType>(total_size, 1, this->legacy_last_reset_type);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2382,6 +2774,11 @@ void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_float_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2402,6 +2799,62 @@ void SensorStateResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
+bool BatchSensorStateResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      value.as_packed_32bit(this->keys);
+      return true;
+    }
+    case 2: {
+      value.as_packed_32bit(this->states);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool BatchSensorStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
+  switch (field_id) {
+    case 1: {
+      this->keys.push_back(value.as_fixed32());
+      return true;
+    }
+    case 2: {
+      this->states.push_back(value.as_float());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void BatchSensorStateResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_packed_32bit(1, this->keys);
+  buffer.encode_packed_32bit(2, this->states);
+}
+void BatchSensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_packed_32bit_field(total_size, 1, this->keys);
+  ProtoSize::add_packed_32bit_field(total_size, 1, this->states);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void BatchSensorStateResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("BatchSensorStateResponse {\n");
+  for (const auto &it : this->keys) {
+    out.append("  keys: ");
+    sprintf(buffer, "%u", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  for (const auto &it : this->states) {
+    out.append("  states: ");
+    sprintf(buffer, "%g", it);
+    out.append(buffer);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
 bool ListEntitiesSwitchResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
     case 6: {
@@ -2467,6 +2920,17 @@ void ListEntitiesSwitchResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
   buffer.encode_string(9, this->device_class);
 }
+void ListEntitiesSwitchResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_bool_field(total_size, 1, this->assumed_state);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+  ProtoSize::add_string_field(total_size, 1, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSwitchResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2534,6 +2998,10 @@ void SwitchStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2573,6 +3041,10 @@ void SwitchCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2643,6 +3115,15 @@ void ListEntitiesTextSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesTextSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTextSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2713,6 +3194,11 @@ void TextSensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextSensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextSensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2750,6 +3236,10 @@ void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
 }
+void SubscribeLogsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_bool_field(total_size, 1, this->dump_config);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2793,6 +3283,11 @@ void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
 }
+void SubscribeLogsResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_string_field(total_size, 1, this->message);
+  ProtoSize::add_bool_field(total_size, 1, this->send_failed);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2812,6 +3307,7 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeassistantServicesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeassistantServicesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeassistantServicesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeassistantServicesRequest {}");
@@ -2835,6 +3331,10 @@ void HomeassistantServiceMap::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->key);
   buffer.encode_string(2, this->value);
 }
+void HomeassistantServiceMap::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceMap::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2894,6 +3394,19 @@ void HomeassistantServiceResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_bool(5, this->is_event);
 }
+void HomeassistantServiceResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->service);
+  for (auto &it : this->data) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 1, it, true);
+  }
+  for (auto &it : this->data_template) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 1, it, true);
+  }
+  for (auto &it : this->variables) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 1, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 1, this->is_event);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2927,6 +3440,7 @@ void HomeassistantServiceResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeAssistantStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeAssistantStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStatesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeAssistantStatesRequest {}");
@@ -2950,6 +3464,10 @@ void SubscribeHomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const
   buffer.encode_string(1, this->entity_id);
   buffer.encode_string(2, this->attribute);
 }
+void SubscribeHomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->entity_id);
+  ProtoSize::add_string_field(total_size, 1, this->attribute);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2967,15 +3485,15 @@ void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
 bool HomeAssistantStateResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->entity_id = value.as_string();
+      this->entity_id = value.as_string_ref();
       return true;
     }
     case 2: {
-      this->state = value.as_string();
+      this->state = value.as_string_ref();
       return true;
     }
     case 3: {
-      this->attribute = value.as_string();
+      this->attribute = value.as_string_ref();
       return true;
     }
     default:
@@ -2987,25 +3505,31 @@ void HomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_string(3, this->attribute);
 }
+void HomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->entity_id);
+  ProtoSize::add_string_field(total_size, 1, this->state);
+  ProtoSize::add_string_field(total_size, 1, this->attribute);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("HomeAssistantStateResponse {\n");
   out.append("  entity_id: ");
-  out.append("'").append(this->entity_id).append("'");
+  out.append("'").append(this->entity_id.c_str(), this->entity_id.size()).append("'");
   out.append("\n");
 
   out.append("  state: ");
-  out.append("'").append(this->state).append("'");
+  out.append("'").append(this->state.c_str(), this->state.size()).append("'");
   out.append("\n");
 
   out.append("  attribute: ");
-  out.append("'").append(this->attribute).append("'");
+  out.append("'").append(this->attribute.c_str(), this->attribute.size()).append("'");
   out.append("\n");
   out.append("}");
 }
 #endif
 void GetTimeRequest::encode(ProtoWriteBuffer buffer) const {}
+void GetTimeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeRequest::dump_to(std::string &out) const { out.append("GetTimeRequest {}"); }
 #endif
@@ -3020,6 +3544,9 @@ bool GetTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void GetTimeResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->epoch_seconds); }
+void GetTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->epoch_seconds);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3055,6 +3582,10 @@ void ListEntitiesServicesArgument::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_enum<enums::ServiceArgType>(2, this->type);
 }
+void ListEntitiesServicesArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_enum_field<enums::ServiceArgType>(total_size, 1, this->type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3100,6 +3631,13 @@ void ListEntitiesServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ListEntitiesServicesArgument>(3, it, true);
   }
 }
+void ListEntitiesServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  for (auto &it : this->args) {
+    ProtoSize::add_message_field<ListEntitiesServicesArgument>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3150,7 +3688,7 @@ bool ExecuteServiceArgument::decode_varint(uint32_t field_id, ProtoVarInt value)
 bool ExecuteServiceArgument::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->string_ = value.as_string();
+      this->string_ = value.as_string_ref();
       return true;
     }
     case 9: {
@@ -3194,6 +3732,25 @@ void ExecuteServiceArgument::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(9, it, true);
   }
 }
+void ExecuteServiceArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->bool_);
+  ProtoSize::add_int32_field(total_size, 1, this->legacy_int);
+  ProtoSize::add_float_field(total_size, 1, this->float_);
+  ProtoSize::add_string_field(total_size, 1, this->string_);
+  ProtoSize::add_sint32_field(total_size, 1, this->int_);
+  for (auto it : this->bool_array) {
+    ProtoSize::add_bool_field(total_size, 1, it, true);
+  }
+  for (auto &it : this->int_array) {
+    ProtoSize::add_sint32_field(total_size, 1, it, true);
+  }
+  for (auto &it : this->float_array) {
+    ProtoSize::add_float_field(total_size, 1, it, true);
+  }
+  for (auto &it : this->string_array) {
+    ProtoSize::add_string_field(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3213,7 +3770,7 @@ void ExecuteServiceArgument::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  string_: ");
-  out.append("'").append(this->string_).append("'");
+  out.append("'").append(this->string_.c_str(), this->string_.size()).append("'");
   out.append("\n");
 
   out.append("  int_: ");
@@ -3275,6 +3832,12 @@ void ExecuteServiceRequest::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ExecuteServiceArgument>(2, it, true);
   }
 }
+void ExecuteServiceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  for (auto &it : this->args) {
+    ProtoSize::add_message_field<ExecuteServiceArgument>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3347,6 +3910,15 @@ void ListEntitiesCameraResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(6, this->icon);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesCameraResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCameraResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3417,6 +3989,11 @@ void CameraImageResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->data);
   buffer.encode_bool(3, this->done);
 }
+void CameraImageResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->data);
+  ProtoSize::add_bool_field(total_size, 1, this->done);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3454,6 +4031,10 @@ void CameraImageRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(1, this->single);
   buffer.encode_bool(2, this->stream);
 }
+void CameraImageRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->single);
+  ProtoSize::add_bool_field(total_size, 1, this->stream);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3605,6 +4186,41 @@ void ListEntitiesClimateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(20, this->entity_category);
   buffer.encode_float(21, this->visual_current_temperature_step);
 }
+void ListEntitiesClimateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_current_temperature);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_two_point_target_temperature);
+  for (auto &it : this->supported_modes) {
+    ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 1, it, true);
+  }
+  ProtoSize::add_float_field(total_size, 1, this->visual_min_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->visual_max_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->visual_target_temperature_step);
+  ProtoSize::add_bool_field(total_size, 1, this->legacy_supports_away);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_action);
+  for (auto &it : this->supported_fan_modes) {
+    ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 1, it, true);
+  }
+  for (auto &it : this->supported_swing_modes) {
+    ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 1, it, true);
+  }
+  for (auto &it : this->supported_custom_fan_modes) {
+    ProtoSize::add_string_field(total_size, 1, it, true);
+  }
+  for (auto &it : this->supported_presets) {
+    ProtoSize::add_enum_field<enums::ClimatePreset>(total_size, 2, it, true);
+  }
+  for (auto &it : this->supported_custom_presets) {
+    ProtoSize::add_string_field(total_size, 2, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 2, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 2, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 2, this->entity_category);
+  ProtoSize::add_float_field(total_size, 2, this->visual_current_temperature_step);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesClimateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3797,6 +4413,21 @@ void ClimateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::ClimatePreset>(12, this->preset);
   buffer.encode_string(13, this->custom_preset);
 }
+void ClimateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 1, this->mode);
+  ProtoSize::add_float_field(total_size, 1, this->current_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->target_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->target_temperature_low);
+  ProtoSize::add_float_field(total_size, 1, this->target_temperature_high);
+  ProtoSize::add_bool_field(total_size, 1, this->unused_legacy_away);
+  ProtoSize::add_enum_field<enums::ClimateAction>(total_size, 1, this->action);
+  ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 1, this->fan_mode);
+  ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 1, this->swing_mode);
+  ProtoSize::add_string_field(total_size, 1, this->custom_fan_mode);
+  ProtoSize::add_enum_field<enums::ClimatePreset>(total_size, 1, this->preset);
+  ProtoSize::add_string_field(total_size, 1, this->custom_preset);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3929,11 +4560,11 @@ bool ClimateCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value)
 bool ClimateCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 17: {
-      this->custom_fan_mode = value.as_string();
+      this->custom_fan_mode = value.as_string_ref();
       return true;
     }
     case 21: {
-      this->custom_preset = value.as_string();
+      this->custom_preset = value.as_string_ref();
       return true;
     }
     default:
@@ -3985,6 +4616,29 @@ void ClimateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(20, this->has_custom_preset);
   buffer.encode_string(21, this->custom_preset);
 }
+void ClimateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->has_mode);
+  ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 1, this->mode);
+  ProtoSize::add_bool_field(total_size, 1, this->has_target_temperature);
+  ProtoSize::add_float_field(total_size, 1, this->target_temperature);
+  ProtoSize::add_bool_field(total_size, 1, this->has_target_temperature_low);
+  ProtoSize::add_float_field(total_size, 1, this->target_temperature_low);
+  ProtoSize::add_bool_field(total_size, 1, this->has_target_temperature_high);
+  ProtoSize::add_float_field(total_size, 1, this->target_temperature_high);
+  ProtoSize::add_bool_field(total_size, 1, this->unused_has_legacy_away);
+  ProtoSize::add_bool_field(total_size, 1, this->unused_legacy_away);
+  ProtoSize::add_bool_field(total_size, 1, this->has_fan_mode);
+  ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 1, this->fan_mode);
+  ProtoSize::add_bool_field(total_size, 1, this->has_swing_mode);
+  ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 1, this->swing_mode);
+  ProtoSize::add_bool_field(total_size, 2, this->has_custom_fan_mode);
+  ProtoSize::add_string_field(total_size, 2, this->custom_fan_mode);
+  ProtoSize::add_bool_field(total_size, 2, this->has_preset);
+  ProtoSize::add_enum_field<enums::ClimatePreset>(total_size, 2, this->preset);
+  ProtoSize::add_bool_field(total_size, 2, this->has_custom_preset);
+  ProtoSize::add_string_field(total_size, 2, this->custom_preset);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4058,7 +4712,7 @@ void ClimateCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  custom_fan_mode: ");
-  out.append("'").append(this->custom_fan_mode).append("'");
+  out.append("'").append(this->custom_fan_mode.c_str(), this->custom_fan_mode.size()).append("'");
   out.append("\n");
 
   out.append("  has_preset: ");
@@ -4074,7 +4728,7 @@ void ClimateCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  custom_preset: ");
-  out.append("'").append(this->custom_preset).append("'");
+  out.append("'").append(this->custom_preset.c_str(), this->custom_preset.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -4164,6 +4818,21 @@ void ListEntitiesNumberResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::NumberMode>(12, this->mode);
   buffer.encode_string(13, this->device_class);
 }
+void ListEntitiesNumberResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_float_field(total_size, 1, this->min_value);
+  ProtoSize::add_float_field(total_size, 1, this->max_value);
+  ProtoSize::add_float_field(total_size, 1, this->step);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+  ProtoSize::add_string_field(total_size, 1, this->unit_of_measurement);
+  ProtoSize::add_enum_field<enums::NumberMode>(total_size, 1, this->mode);
+  ProtoSize::add_string_field(total_size, 1, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesNumberResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4255,6 +4924,11 @@ void NumberStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void NumberStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_float_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4293,6 +4967,10 @@ void NumberCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
 }
+void NumberCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_float_field(total_size, 1, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4371,6 +5049,18 @@ void ListEntitiesSelectResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(7, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
 }
+void ListEntitiesSelectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  for (auto &it : this->options) {
+    ProtoSize::add_string_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSelectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4447,6 +5137,11 @@ void SelectStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SelectStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->state);
+  ProtoSize::add_bool_field(total_size, 1, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4469,7 +5164,7 @@ void SelectStateResponse::dump_to(std::string &out) const {
 bool SelectCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 2: {
-      this->state = value.as_string();
+      this->state = value.as_string_ref();
       return true;
     }
     default:
@@ -4490,6 +5185,10 @@ void SelectCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
+void SelectCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4500,7 +5199,7 @@ void SelectCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  state: ");
-  out.append("'").append(this->state).append("'");
+  out.append("'").append(this->state.c_str(), this->state.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -4580,6 +5279,19 @@ void ListEntitiesLockResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(10, this->requires_code);
   buffer.encode_string(11, this->code_format);
 }
+void ListEntitiesLockResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+  ProtoSize::add_bool_field(total_size, 1, this->assumed_state);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_open);
+  ProtoSize::add_bool_field(total_size, 1, this->requires_code);
+  ProtoSize::add_string_field(total_size, 1, this->code_format);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLockResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4655,6 +5367,10 @@ void LockStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::LockState>(2, this->state);
 }
+void LockStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::LockState>(total_size, 1, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4687,7 +5403,7 @@ bool LockCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool LockCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->code = value.as_string();
+      this->code = value.as_string_ref();
       return true;
     }
     default:
@@ -4710,6 +5426,12 @@ void LockCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_code);
   buffer.encode_string(4, this->code);
 }
+void LockCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::LockCommand>(total_size, 1, this->command);
+  ProtoSize::add_bool_field(total_size, 1, this->has_code);
+  ProtoSize::add_string_field(total_size, 1, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4728,7 +5450,7 @@ void LockCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  code: ");
-  out.append("'").append(this->code).append("'");
+  out.append("'").append(this->code.c_str(), this->code.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -4793,6 +5515,16 @@ void ListEntitiesButtonResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesButtonResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+  ProtoSize::add_string_field(total_size, 1, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesButtonResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4843,6 +5575,9 @@ bool ButtonCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void ButtonCommandRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->key); }
+void ButtonCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ButtonCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4914,6 +5649,16 @@ void ListEntitiesMediaPlayerResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_bool(8, this->supports_pause);
 }
+void ListEntitiesMediaPlayerResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+  ProtoSize::add_bool_field(total_size, 1, this->supports_pause);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesMediaPlayerResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4987,6 +5732,12 @@ void MediaPlayerStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(3, this->volume);
   buffer.encode_bool(4, this->muted);
 }
+void MediaPlayerStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::MediaPlayerState>(total_size, 1, this->state);
+  ProtoSize::add_float_field(total_size, 1, this->volume);
+  ProtoSize::add_bool_field(total_size, 1, this->muted);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5036,7 +5787,7 @@ bool MediaPlayerCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt val
 bool MediaPlayerCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 7: {
-      this->media_url = value.as_string();
+      this->media_url = value.as_string_ref();
       return true;
     }
     default:
@@ -5066,6 +5817,15 @@ void MediaPlayerCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->has_media_url);
   buffer.encode_string(7, this->media_url);
 }
+void MediaPlayerCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 1, this->has_command);
+  ProtoSize::add_enum_field<enums::MediaPlayerCommand>(total_size, 1, this->command);
+  ProtoSize::add_bool_field(total_size, 1, this->has_volume);
+  ProtoSize::add_float_field(total_size, 1, this->volume);
+  ProtoSize::add_bool_field(total_size, 1, this->has_media_url);
+  ProtoSize::add_string_field(total_size, 1, this->media_url);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5097,7 +5857,7 @@ void MediaPlayerCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  media_url: ");
-  out.append("'").append(this->media_url).append("'");
+  out.append("'").append(this->media_url.c_str(), this->media_url.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -5115,6 +5875,9 @@ bool SubscribeBluetoothLEAdvertisementsRequest::decode_varint(uint32_t field_id,
 void SubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->flags);
 }
+void SubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->flags);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5157,6 +5920,13 @@ void BluetoothServiceData::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_string(3, this->data);
 }
+void BluetoothServiceData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->uuid);
+  for (auto &it : this->legacy_data) {
+    ProtoSize::add_uint32_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_string_field(total_size, 1, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothServiceData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5233,6 +6003,21 @@ void BluetoothLEAdvertisementResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(7, this->address_type);
 }
+void BluetoothLEAdvertisementResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_sint32_field(total_size, 1, this->rssi);
+  for (auto &it : this->service_uuids) {
+    ProtoSize::add_string_field(total_size, 1, it, true);
+  }
+  for (auto &it : this->service_data) {
+    ProtoSize::add_message_field<BluetoothServiceData>(total_size, 1, it, true);
+  }
+  for (auto &it : this->manufacturer_data) {
+    ProtoSize::add_message_field<BluetoothServiceData>(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 1, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLEAdvertisementResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5310,6 +6095,12 @@ void BluetoothLERawAdvertisement::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->address_type);
   buffer.encode_string(4, this->data);
 }
+void BluetoothLERawAdvertisement::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_sint32_field(total_size, 1, this->rssi);
+  ProtoSize::add_uint32_field(total_size, 1, this->address_type);
+  ProtoSize::add_string_field(total_size, 1, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisement::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5350,6 +6141,11 @@ void BluetoothLERawAdvertisementsResponse::encode(ProtoWriteBuffer buffer) const
     buffer.encode_message<BluetoothLERawAdvertisement>(1, it, true);
   }
 }
+void BluetoothLERawAdvertisementsResponse::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->advertisements) {
+    ProtoSize::add_message_field<BluetoothLERawAdvertisement>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisementsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5390,6 +6186,12 @@ void BluetoothDeviceRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_address_type);
   buffer.encode_uint32(4, this->address_type);
 }
+void BluetoothDeviceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_enum_field<enums::BluetoothDeviceRequestType>(total_size, 1, this->request_type);
+  ProtoSize::add_bool_field(total_size, 1, this->has_address_type);
+  ProtoSize::add_uint32_field(total_size, 1, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5442,6 +6244,12 @@ void BluetoothDeviceConnectionResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->mtu);
   buffer.encode_int32(4, this->error);
 }
+void BluetoothDeviceConnectionResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 1, this->connected);
+  ProtoSize::add_uint32_field(total_size, 1, this->mtu);
+  ProtoSize::add_int32_field(total_size, 1, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceConnectionResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5478,6 +6286,9 @@ bool BluetoothGATTGetServicesRequest::decode_varint(uint32_t field_id, ProtoVarI
   }
 }
 void BluetoothGATTGetServicesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_uint64(1, this->address); }
+void BluetoothGATTGetServicesRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5509,6 +6320,12 @@ void BluetoothGATTDescriptor::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTDescriptor::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->uuid) {
+    ProtoSize::add_uint64_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTDescriptor::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5565,6 +6382,16 @@ void BluetoothGATTCharacteristic::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTDescriptor>(4, it, true);
   }
 }
+void BluetoothGATTCharacteristic::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->uuid) {
+    ProtoSize::add_uint64_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  ProtoSize::add_uint32_field(total_size, 1, this->properties);
+  for (auto &it : this->descriptors) {
+    ProtoSize::add_message_field<BluetoothGATTDescriptor>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTCharacteristic::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5627,6 +6454,15 @@ void BluetoothGATTService::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTCharacteristic>(3, it, true);
   }
 }
+void BluetoothGATTService::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->uuid) {
+    ProtoSize::add_uint64_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  for (auto &it : this->characteristics) {
+    ProtoSize::add_message_field<BluetoothGATTCharacteristic>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTService::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5677,6 +6513,12 @@ void BluetoothGATTGetServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTService>(2, it, true);
   }
 }
+void BluetoothGATTGetServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  for (auto &it : this->services) {
+    ProtoSize::add_message_field<BluetoothGATTService>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5707,6 +6549,9 @@ bool BluetoothGATTGetServicesDoneResponse::decode_varint(uint32_t field_id, Prot
 void BluetoothGATTGetServicesDoneResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
 }
+void BluetoothGATTGetServicesDoneResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesDoneResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5736,6 +6581,10 @@ void BluetoothGATTReadRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5781,6 +6630,11 @@ void BluetoothGATTReadResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTReadResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  ProtoSize::add_string_field(total_size, 1, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5822,7 +6676,7 @@ bool BluetoothGATTWriteRequest::decode_varint(uint32_t field_id, ProtoVarInt val
 bool BluetoothGATTWriteRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
@@ -5835,6 +6689,12 @@ void BluetoothGATTWriteRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->response);
   buffer.encode_string(4, this->data);
 }
+void BluetoothGATTWriteRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  ProtoSize::add_bool_field(total_size, 1, this->response);
+  ProtoSize::add_string_field(total_size, 1, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5854,7 +6714,7 @@ void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -5877,6 +6737,10 @@ void BluetoothGATTReadDescriptorRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5910,7 +6774,7 @@ bool BluetoothGATTWriteDescriptorRequest::decode_varint(uint32_t field_id, Proto
 bool BluetoothGATTWriteDescriptorRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 3: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
@@ -5922,6 +6786,11 @@ void BluetoothGATTWriteDescriptorRequest::encode(ProtoWriteBuffer buffer) const
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTWriteDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  ProtoSize::add_string_field(total_size, 1, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5937,7 +6806,7 @@ void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -5965,6 +6834,11 @@ void BluetoothGATTNotifyRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_bool(3, this->enable);
 }
+void BluetoothGATTNotifyRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  ProtoSize::add_bool_field(total_size, 1, this->enable);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6014,6 +6888,11 @@ void BluetoothGATTNotifyDataResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTNotifyDataResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  ProtoSize::add_string_field(total_size, 1, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6035,6 +6914,7 @@ void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeBluetoothConnectionsFreeRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeBluetoothConnectionsFreeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothConnectionsFreeRequest::dump_to(std::string &out) const {
   out.append("SubscribeBluetoothConnectionsFreeRequest {}");
@@ -6058,6 +6938,10 @@ void BluetoothConnectionsFreeResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->free);
   buffer.encode_uint32(2, this->limit);
 }
+void BluetoothConnectionsFreeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->free);
+  ProtoSize::add_uint32_field(total_size, 1, this->limit);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothConnectionsFreeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6097,6 +6981,11 @@ void BluetoothGATTErrorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothGATTErrorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+  ProtoSize::add_int32_field(total_size, 1, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTErrorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6136,6 +7025,10 @@ void BluetoothGATTWriteResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTWriteResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6170,6 +7063,10 @@ void BluetoothGATTNotifyResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTNotifyResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 1, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6209,6 +7106,11 @@ void BluetoothDevicePairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->paired);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDevicePairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 1, this->paired);
+  ProtoSize::add_int32_field(total_size, 1, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDevicePairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6252,6 +7154,11 @@ void BluetoothDeviceUnpairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceUnpairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 1, this->success);
+  ProtoSize::add_int32_field(total_size, 1, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6273,6 +7180,7 @@ void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
 }
 #endif
 void UnsubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {}
+void UnsubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void UnsubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   out.append("UnsubscribeBluetoothLEAdvertisementsRequest {}");
@@ -6301,6 +7209,11 @@ void BluetoothDeviceClearCacheResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceClearCacheResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 1, this->success);
+  ProtoSize::add_int32_field(total_size, 1, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceClearCacheResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6332,6 +7245,9 @@ bool SubscribeVoiceAssistantRequest::decode_varint(uint32_t field_id, ProtoVarIn
   }
 }
 void SubscribeVoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->subscribe); }
+void SubscribeVoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->subscribe);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeVoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6371,6 +7287,11 @@ void VoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->conversation_id);
   buffer.encode_bool(3, this->use_vad);
 }
+void VoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->start);
+  ProtoSize::add_string_field(total_size, 1, this->conversation_id);
+  ProtoSize::add_bool_field(total_size, 1, this->use_vad);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6407,6 +7328,10 @@ void VoiceAssistantResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->port);
   buffer.encode_bool(2, this->error);
 }
+void VoiceAssistantResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->port);
+  ProtoSize::add_bool_field(total_size, 1, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6425,11 +7350,11 @@ void VoiceAssistantResponse::dump_to(std::string &out) const {
 bool VoiceAssistantEventData::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->name = value.as_string();
+      this->name = value.as_string_ref();
       return true;
     }
     case 2: {
-      this->value = value.as_string();
+      this->value = value.as_string_ref();
       return true;
     }
     default:
@@ -6440,16 +7365,20 @@ void VoiceAssistantEventData::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_string(2, this->value);
 }
+void VoiceAssistantEventData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("VoiceAssistantEventData {\n");
   out.append("  name: ");
-  out.append("'").append(this->name).append("'");
+  out.append("'").append(this->name.c_str(), this->name.size()).append("'");
   out.append("\n");
 
   out.append("  value: ");
-  out.append("'").append(this->value).append("'");
+  out.append("'").append(this->value.c_str(), this->value.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -6480,6 +7409,12 @@ void VoiceAssistantEventResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<VoiceAssistantEventData>(2, it, true);
   }
 }
+void VoiceAssistantEventResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::VoiceAssistantEvent>(total_size, 1, this->event_type);
+  for (auto &it : this->data) {
+    ProtoSize::add_message_field<VoiceAssistantEventData>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6566,6 +7501,18 @@ void ListEntitiesAlarmControlPanelResponse::encode(ProtoWriteBuffer buffer) cons
   buffer.encode_bool(9, this->requires_code);
   buffer.encode_bool(10, this->requires_code_to_arm);
 }
+void ListEntitiesAlarmControlPanelResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 1, this->unique_id);
+  ProtoSize::add_string_field(total_size, 1, this->icon);
+  ProtoSize::add_bool_field(total_size, 1, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 1, this->entity_category);
+  ProtoSize::add_uint32_field(total_size, 1, this->supported_features);
+  ProtoSize::add_bool_field(total_size, 1, this->requires_code);
+  ProtoSize::add_bool_field(total_size, 1, this->requires_code_to_arm);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesAlarmControlPanelResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6638,6 +7585,10 @@ void AlarmControlPanelStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::AlarmControlPanelState>(2, this->state);
 }
+void AlarmControlPanelStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::AlarmControlPanelState>(total_size, 1, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6666,7 +7617,7 @@ bool AlarmControlPanelCommandRequest::decode_varint(uint32_t field_id, ProtoVarI
 bool AlarmControlPanelCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 3: {
-      this->code = value.as_string();
+      this->code = value.as_string_ref();
       return true;
     }
     default:
@@ -6688,6 +7639,11 @@ void AlarmControlPanelCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::AlarmControlPanelStateCommand>(2, this->command);
   buffer.encode_string(3, this->code);
 }
+void AlarmControlPanelCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::AlarmControlPanelStateCommand>(total_size, 1, this->command);
+  ProtoSize::add_string_field(total_size, 1, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6702,11 +7658,396 @@ void AlarmControlPanelCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  code: ");
-  out.append("'").append(this->code).append("'");
+  out.append("'").append(this->code.c_str(), this->code.size()).append("'");
   out.append("\n");
   out.append("}");
 }
 #endif
+void ComponentProfileRequest::encode(ProtoWriteBuffer buffer) const {}
+void ComponentProfileRequest::calculate_size(uint32_t &total_size) const {}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ComponentProfileRequest::dump_to(std::string &out) const { out.append("ComponentProfileRequest {}"); }
+#endif
+bool ComponentProfile::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->loop_count = value.as_uint32();
+      return true;
+    }
+    case 3: {
+      this->loop_time_us = value.as_uint64();
+      return true;
+    }
+    case 4: {
+      this->loop_max_us = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->scheduler_count = value.as_uint32();
+      return true;
+    }
+    case 6: {
+      this->scheduler_time_us = value.as_uint64();
+      return true;
+    }
+    case 7: {
+      this->scheduler_max_us = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ComponentProfile::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->source = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentProfile::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_string(1, this->source);
+  buffer.encode_uint32(2, this->loop_count);
+  buffer.encode_uint64(3, this->loop_time_us);
+  buffer.encode_uint32(4, this->loop_max_us);
+  buffer.encode_uint32(5, this->scheduler_count);
+  buffer.encode_uint64(6, this->scheduler_time_us);
+  buffer.encode_uint32(7, this->scheduler_max_us);
+}
+void ComponentProfile::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->source);
+  ProtoSize::add_uint32_field(total_size, 1, this->loop_count);
+  ProtoSize::add_uint64_field(total_size, 1, this->loop_time_us);
+  ProtoSize::add_uint32_field(total_size, 1, this->loop_max_us);
+  ProtoSize::add_uint32_field(total_size, 1, this->scheduler_count);
+  ProtoSize::add_uint64_field(total_size, 1, this->scheduler_time_us);
+  ProtoSize::add_uint32_field(total_size, 1, this->scheduler_max_us);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ComponentProfile::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ComponentProfile {\n");
+  out.append("  source: ");
+  out.append("'").append(this->source).append("'");
+  out.append("\n");
+
+  out.append("  loop_count: ");
+  sprintf(buffer, "%u", this->loop_count);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  loop_time_us: ");
+  sprintf(buffer, "%llu", this->loop_time_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  loop_max_us: ");
+  sprintf(buffer, "%u", this->loop_max_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  scheduler_count: ");
+  sprintf(buffer, "%u", this->scheduler_count);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  scheduler_time_us: ");
+  sprintf(buffer, "%llu", this->scheduler_time_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  scheduler_max_us: ");
+  sprintf(buffer, "%u", this->scheduler_max_us);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool ComponentProfileResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->uptime_us = value.as_uint64();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ComponentProfileResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 2: {
+      this->components.push_back(value.as_message<ComponentProfile>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentProfileResponse::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_uint64(1, this->uptime_us);
+  for (auto &it : this->components) {
+    buffer.encode_message<ComponentProfile>(2, it, true);
+  }
+}
+void ComponentProfileResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->uptime_us);
+  for (auto &it : this->components) {
+    ProtoSize::add_message_field<ComponentProfile>(total_size, 1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ComponentProfileResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ComponentProfileResponse {\n");
+  out.append("  uptime_us: ");
+  sprintf(buffer, "%llu", this->uptime_us);
+  out.append(buffer);
+  out.append("\n");
+
+  for (const auto &it : this->components) {
+    out.append("  components: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
+void ConnectionStatsRequest::encode(ProtoWriteBuffer buffer) const {}
+void ConnectionStatsRequest::calculate_size(uint32_t &total_size) const {}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ConnectionStatsRequest::dump_to(std::string &out) const { out.append("ConnectionStatsRequest {}"); }
+#endif
+bool MessageTypeStats::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->type = value.as_uint32();
+      return true;
+    }
+    case 2: {
+      this->messages_received = value.as_uint32();
+      return true;
+    }
+    case 3: {
+      this->bytes_received = value.as_uint32();
+      return true;
+    }
+    case 4: {
+      this->messages_sent = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->bytes_sent = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void MessageTypeStats::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_uint32(1, this->type);
+  buffer.encode_uint32(2, this->messages_received);
+  buffer.encode_uint32(3, this->bytes_received);
+  buffer.encode_uint32(4, this->messages_sent);
+  buffer.encode_uint32(5, this->bytes_sent);
+}
+void MessageTypeStats::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->type);
+  ProtoSize::add_uint32_field(total_size, 1, this->messages_received);
+  ProtoSize::add_uint32_field(total_size, 1, this->bytes_received);
+  ProtoSize::add_uint32_field(total_size, 1, this->messages_sent);
+  ProtoSize::add_uint32_field(total_size, 1, this->bytes_sent);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void MessageTypeStats::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("MessageTypeStats {\n");
+  out.append("  type: ");
+  sprintf(buffer, "%u", this->type);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  messages_received: ");
+  sprintf(buffer, "%u", this->messages_received);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  bytes_received: ");
+  sprintf(buffer, "%u", this->bytes_received);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  messages_sent: ");
+  sprintf(buffer, "%u", this->messages_sent);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  bytes_sent: ");
+  sprintf(buffer, "%u", this->bytes_sent);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool ConnectionStats::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->connected_ms = value.as_uint32();
+      return true;
+    }
+    case 3: {
+      this->send_buffer_full = value.as_uint32();
+      return true;
+    }
+    case 4: {
+      this->deferred_states = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->dropped_states = value.as_uint32();
+      return true;
+    }
+    case 6: {
+      this->command_count = value.as_uint32();
+      return true;
+    }
+    case 7: {
+      this->command_latency_avg_us = value.as_uint32();
+      return true;
+    }
+    case 8: {
+      this->command_latency_max_us = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ConnectionStats::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->client_info = value.as_string();
+      return true;
+    }
+    case 9: {
+      this->message_types.push_back(value.as_message<MessageTypeStats>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ConnectionStats::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_string(1, this->client_info);
+  buffer.encode_uint32(2, this->connected_ms);
+  buffer.encode_uint32(3, this->send_buffer_full);
+  buffer.encode_uint32(4, this->deferred_states);
+  buffer.encode_uint32(5, this->dropped_states);
+  buffer.encode_uint32(6, this->command_count);
+  buffer.encode_uint32(7, this->command_latency_avg_us);
+  buffer.encode_uint32(8, this->command_latency_max_us);
+  for (auto &it : this->message_types) {
+    buffer.encode_message<MessageTypeStats>(9, it, true);
+  }
+}
+void ConnectionStats::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->client_info);
+  ProtoSize::add_uint32_field(total_size, 1, this->connected_ms);
+  ProtoSize::add_uint32_field(total_size, 1, this->send_buffer_full);
+  ProtoSize::add_uint32_field(total_size, 1, this->deferred_states);
+  ProtoSize::add_uint32_field(total_size, 1, this->dropped_states);
+  ProtoSize::add_uint32_field(total_size, 1, this->command_count);
+  ProtoSize::add_uint32_field(total_size, 1, this->command_latency_avg_us);
+  ProtoSize::add_uint32_field(total_size, 1, this->command_latency_max_us);
+  for (auto &it : this->message_types) {
+    ProtoSize::add_message_field<MessageTypeStats>(total_size, 1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ConnectionStats::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ConnectionStats {\n");
+  out.append("  client_info: ");
+  out.append("'").append(this->client_info).append("'");
+  out.append("\n");
+
+  out.append("  connected_ms: ");
+  sprintf(buffer, "%u", this->connected_ms);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  send_buffer_full: ");
+  sprintf(buffer, "%u", this->send_buffer_full);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  deferred_states: ");
+  sprintf(buffer, "%u", this->deferred_states);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  dropped_states: ");
+  sprintf(buffer, "%u", this->dropped_states);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  command_count: ");
+  sprintf(buffer, "%u", this->command_count);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  command_latency_avg_us: ");
+  sprintf(buffer, "%u", this->command_latency_avg_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  command_latency_max_us: ");
+  sprintf(buffer, "%u", this->command_latency_max_us);
+  out.append(buffer);
+  out.append("\n");
+
+  for (const auto &it : this->message_types) {
+    out.append("  message_types: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
+bool ConnectionStatsResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->connections.push_back(value.as_message<ConnectionStats>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ConnectionStatsResponse::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->connections) {
+    buffer.encode_message<ConnectionStats>(1, it, true);
+  }
+}
+void ConnectionStatsResponse::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->connections) {
+    ProtoSize::add_message_field<ConnectionStats>(total_size, 1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ConnectionStatsResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ConnectionStatsResponse {\n");
+  for (const auto &it : this->connections) {
+    out.append("  connections: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -3,6 +3,9 @@
 #include "api_pb2_service.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace api {
 
@@ -142,6 +145,14 @@ bool APIServerConnectionBase::send_sensor_state_response(const SensorStateRespon
   return this->send_message_<SensorStateResponse>(msg, 25);
 }
 #endif
+#ifdef USE_API_SENSOR_BATCH
+bool APIServerConnectionBase::send_batch_sensor_state_response(const BatchSensorStateResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_batch_sensor_state_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<BatchSensorStateResponse>(msg, 99);
+}
+#endif
 #ifdef USE_SWITCH
 bool APIServerConnectionBase::send_list_entities_switch_response(const ListEntitiesSwitchResponse &msg) {
 #ifdef HAS_PROTO_MESSAGE_DUMP
@@ -495,430 +506,201 @@ bool APIServerConnectionBase::send_alarm_control_panel_state_response(const Alar
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
 #endif
-bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
-  switch (msg_type) {
-    case 1: {
-      HelloRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_hello_request: %s", msg.dump().c_str());
-#endif
-      this->on_hello_request(msg);
-      break;
-    }
-    case 3: {
-      ConnectRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_connect_request: %s", msg.dump().c_str());
-#endif
-      this->on_connect_request(msg);
-      break;
-    }
-    case 5: {
-      DisconnectRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_disconnect_request: %s", msg.dump().c_str());
-#endif
-      this->on_disconnect_request(msg);
-      break;
-    }
-    case 6: {
-      DisconnectResponse msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_disconnect_response: %s", msg.dump().c_str());
-#endif
-      this->on_disconnect_response(msg);
-      break;
-    }
-    case 7: {
-      PingRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_ping_request: %s", msg.dump().c_str());
-#endif
-      this->on_ping_request(msg);
-      break;
-    }
-    case 8: {
-      PingResponse msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_ping_response: %s", msg.dump().c_str());
-#endif
-      this->on_ping_response(msg);
-      break;
-    }
-    case 9: {
-      DeviceInfoRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_device_info_request: %s", msg.dump().c_str());
-#endif
-      this->on_device_info_request(msg);
-      break;
-    }
-    case 11: {
-      ListEntitiesRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_list_entities_request: %s", msg.dump().c_str());
-#endif
-      this->on_list_entities_request(msg);
-      break;
-    }
-    case 20: {
-      SubscribeStatesRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_subscribe_states_request: %s", msg.dump().c_str());
-#endif
-      this->on_subscribe_states_request(msg);
-      break;
-    }
-    case 28: {
-      SubscribeLogsRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_subscribe_logs_request: %s", msg.dump().c_str());
+#ifdef USE_COMPONENT_PROFILER
 #endif
-      this->on_subscribe_logs_request(msg);
-      break;
-    }
-    case 30: {
-#ifdef USE_COVER
-      CoverCommandRequest msg;
-      msg.decode(msg_data, msg_size);
+#ifdef USE_COMPONENT_PROFILER
+bool APIServerConnectionBase::send_component_profile_response(const ComponentProfileResponse &msg) {
 #ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_cover_command_request: %s", msg.dump().c_str());
+  ESP_LOGVV(TAG, "send_component_profile_response: %s", msg.dump().c_str());
 #endif
-      this->on_cover_command_request(msg);
-#endif
-      break;
-    }
-    case 31: {
-#ifdef USE_FAN
-      FanCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_fan_command_request: %s", msg.dump().c_str());
+  return this->send_message_<ComponentProfileResponse>(msg, 98);
+}
 #endif
-      this->on_fan_command_request(msg);
+#ifdef USE_API_CONNECTION_STATS
 #endif
-      break;
-    }
-    case 32: {
-#ifdef USE_LIGHT
-      LightCommandRequest msg;
-      msg.decode(msg_data, msg_size);
+#ifdef USE_API_CONNECTION_STATS
+bool APIServerConnectionBase::send_connection_stats_response(const ConnectionStatsResponse &msg) {
 #ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_light_command_request: %s", msg.dump().c_str());
+  ESP_LOGVV(TAG, "send_connection_stats_response: %s", msg.dump().c_str());
 #endif
-      this->on_light_command_request(msg);
+  return this->send_message_<ConnectionStatsResponse>(msg, 101);
+}
 #endif
-      break;
-    }
-    case 33: {
-#ifdef USE_SWITCH
-      SwitchCommandRequest msg;
-      msg.decode(msg_data, msg_size);
+static const uint8_t NEEDS_SETUP_CONNECTION = 1 << 0;
+static const uint8_t NEEDS_AUTHENTICATION = 1 << 1;
+
+struct MessageHandler {
+  uint16_t msg_type;
+  uint8_t requirements;
+  void (*handle)(APIServerConnectionBase *conn, uint8_t *msg_data, uint32_t msg_size);
+};
+
+template<class T, void (APIServerConnectionBase::*Handler)(const T &)>
+static void handle_message(APIServerConnectionBase *conn, uint8_t *msg_data, uint32_t msg_size) {
+  T msg;
+  msg.decode(msg_data, msg_size);
 #ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_switch_command_request: %s", msg.dump().c_str());
+  ESP_LOGVV(TAG, "Received %s", msg.dump().c_str());
 #endif
-      this->on_switch_command_request(msg);
+  (conn->*Handler)(msg);
+}
+
+// Sorted by message type
+static constexpr MessageHandler MESSAGE_HANDLERS[] = {
+    {1, 0, handle_message<HelloRequest, &APIServerConnectionBase::on_hello_request>},
+    {3, 0, handle_message<ConnectRequest, &APIServerConnectionBase::on_connect_request>},
+    {5, 0, handle_message<DisconnectRequest, &APIServerConnectionBase::on_disconnect_request>},
+    {6, 0, handle_message<DisconnectResponse, &APIServerConnectionBase::on_disconnect_response>},
+    {7, 0, handle_message<PingRequest, &APIServerConnectionBase::on_ping_request>},
+    {8, 0, handle_message<PingResponse, &APIServerConnectionBase::on_ping_response>},
+    {9, NEEDS_SETUP_CONNECTION, handle_message<DeviceInfoRequest, &APIServerConnectionBase::on_device_info_request>},
+    {11, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<ListEntitiesRequest, &APIServerConnectionBase::on_list_entities_request>},
+    {20, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SubscribeStatesRequest, &APIServerConnectionBase::on_subscribe_states_request>},
+    {28, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SubscribeLogsRequest, &APIServerConnectionBase::on_subscribe_logs_request>},
+#ifdef USE_COVER
+    {30, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<CoverCommandRequest, &APIServerConnectionBase::on_cover_command_request>},
 #endif
-      break;
-    }
-    case 34: {
-      SubscribeHomeassistantServicesRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_subscribe_homeassistant_services_request: %s", msg.dump().c_str());
-#endif
-      this->on_subscribe_homeassistant_services_request(msg);
-      break;
-    }
-    case 36: {
-      GetTimeRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_get_time_request: %s", msg.dump().c_str());
-#endif
-      this->on_get_time_request(msg);
-      break;
-    }
-    case 37: {
-      GetTimeResponse msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_get_time_response: %s", msg.dump().c_str());
-#endif
-      this->on_get_time_response(msg);
-      break;
-    }
-    case 38: {
-      SubscribeHomeAssistantStatesRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_subscribe_home_assistant_states_request: %s", msg.dump().c_str());
-#endif
-      this->on_subscribe_home_assistant_states_request(msg);
-      break;
-    }
-    case 40: {
-      HomeAssistantStateResponse msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_home_assistant_state_response: %s", msg.dump().c_str());
-#endif
-      this->on_home_assistant_state_response(msg);
-      break;
-    }
-    case 42: {
-      ExecuteServiceRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_execute_service_request: %s", msg.dump().c_str());
+#ifdef USE_FAN
+    {31, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<FanCommandRequest, &APIServerConnectionBase::on_fan_command_request>},
 #endif
-      this->on_execute_service_request(msg);
-      break;
-    }
-    case 45: {
-#ifdef USE_ESP32_CAMERA
-      CameraImageRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_camera_image_request: %s", msg.dump().c_str());
+#ifdef USE_LIGHT
+    {32, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<LightCommandRequest, &APIServerConnectionBase::on_light_command_request>},
 #endif
-      this->on_camera_image_request(msg);
+#ifdef USE_SWITCH
+    {33, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SwitchCommandRequest, &APIServerConnectionBase::on_switch_command_request>},
+#endif
+    {34, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SubscribeHomeassistantServicesRequest,
+                    &APIServerConnectionBase::on_subscribe_homeassistant_services_request>},
+    {36, NEEDS_SETUP_CONNECTION, handle_message<GetTimeRequest, &APIServerConnectionBase::on_get_time_request>},
+    {37, 0, handle_message<GetTimeResponse, &APIServerConnectionBase::on_get_time_response>},
+    {38, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SubscribeHomeAssistantStatesRequest,
+                    &APIServerConnectionBase::on_subscribe_home_assistant_states_request>},
+    {40, 0, handle_message<HomeAssistantStateResponse, &APIServerConnectionBase::on_home_assistant_state_response>},
+    {42, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<ExecuteServiceRequest, &APIServerConnectionBase::on_execute_service_request>},
+#ifdef USE_ESP32_CAMERA
+    {45, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<CameraImageRequest, &APIServerConnectionBase::on_camera_image_request>},
 #endif
-      break;
-    }
-    case 48: {
 #ifdef USE_CLIMATE
-      ClimateCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_climate_command_request: %s", msg.dump().c_str());
-#endif
-      this->on_climate_command_request(msg);
+    {48, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<ClimateCommandRequest, &APIServerConnectionBase::on_climate_command_request>},
 #endif
-      break;
-    }
-    case 51: {
 #ifdef USE_NUMBER
-      NumberCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_number_command_request: %s", msg.dump().c_str());
-#endif
-      this->on_number_command_request(msg);
+    {51, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<NumberCommandRequest, &APIServerConnectionBase::on_number_command_request>},
 #endif
-      break;
-    }
-    case 54: {
 #ifdef USE_SELECT
-      SelectCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_select_command_request: %s", msg.dump().c_str());
-#endif
-      this->on_select_command_request(msg);
+    {54, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SelectCommandRequest, &APIServerConnectionBase::on_select_command_request>},
 #endif
-      break;
-    }
-    case 60: {
 #ifdef USE_LOCK
-      LockCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_lock_command_request: %s", msg.dump().c_str());
-#endif
-      this->on_lock_command_request(msg);
+    {60, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<LockCommandRequest, &APIServerConnectionBase::on_lock_command_request>},
 #endif
-      break;
-    }
-    case 62: {
 #ifdef USE_BUTTON
-      ButtonCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_button_command_request: %s", msg.dump().c_str());
+    {62, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<ButtonCommandRequest, &APIServerConnectionBase::on_button_command_request>},
 #endif
-      this->on_button_command_request(msg);
-#endif
-      break;
-    }
-    case 65: {
 #ifdef USE_MEDIA_PLAYER
-      MediaPlayerCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_media_player_command_request: %s", msg.dump().c_str());
+    {65, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<MediaPlayerCommandRequest, &APIServerConnectionBase::on_media_player_command_request>},
 #endif
-      this->on_media_player_command_request(msg);
-#endif
-      break;
-    }
-    case 66: {
 #ifdef USE_BLUETOOTH_PROXY
-      SubscribeBluetoothLEAdvertisementsRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_subscribe_bluetooth_le_advertisements_request: %s", msg.dump().c_str());
+    {66, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SubscribeBluetoothLEAdvertisementsRequest,
+                    &APIServerConnectionBase::on_subscribe_bluetooth_le_advertisements_request>},
 #endif
-      this->on_subscribe_bluetooth_le_advertisements_request(msg);
-#endif
-      break;
-    }
-    case 68: {
 #ifdef USE_BLUETOOTH_PROXY
-      BluetoothDeviceRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_bluetooth_device_request: %s", msg.dump().c_str());
-#endif
-      this->on_bluetooth_device_request(msg);
+    {68, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<BluetoothDeviceRequest, &APIServerConnectionBase::on_bluetooth_device_request>},
 #endif
-      break;
-    }
-    case 70: {
 #ifdef USE_BLUETOOTH_PROXY
-      BluetoothGATTGetServicesRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_bluetooth_gatt_get_services_request: %s", msg.dump().c_str());
-#endif
-      this->on_bluetooth_gatt_get_services_request(msg);
+    {70, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<BluetoothGATTGetServicesRequest, &APIServerConnectionBase::on_bluetooth_gatt_get_services_request>},
 #endif
-      break;
-    }
-    case 73: {
 #ifdef USE_BLUETOOTH_PROXY
-      BluetoothGATTReadRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_bluetooth_gatt_read_request: %s", msg.dump().c_str());
-#endif
-      this->on_bluetooth_gatt_read_request(msg);
+    {73, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<BluetoothGATTReadRequest, &APIServerConnectionBase::on_bluetooth_gatt_read_request>},
 #endif
-      break;
-    }
-    case 75: {
 #ifdef USE_BLUETOOTH_PROXY
-      BluetoothGATTWriteRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_bluetooth_gatt_write_request: %s", msg.dump().c_str());
-#endif
-      this->on_bluetooth_gatt_write_request(msg);
+    {75, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<BluetoothGATTWriteRequest, &APIServerConnectionBase::on_bluetooth_gatt_write_request>},
 #endif
-      break;
-    }
-    case 76: {
 #ifdef USE_BLUETOOTH_PROXY
-      BluetoothGATTReadDescriptorRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_bluetooth_gatt_read_descriptor_request: %s", msg.dump().c_str());
+    {76, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<BluetoothGATTReadDescriptorRequest,
+                    &APIServerConnectionBase::on_bluetooth_gatt_read_descriptor_request>},
 #endif
-      this->on_bluetooth_gatt_read_descriptor_request(msg);
-#endif
-      break;
-    }
-    case 77: {
 #ifdef USE_BLUETOOTH_PROXY
-      BluetoothGATTWriteDescriptorRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_bluetooth_gatt_write_descriptor_request: %s", msg.dump().c_str());
+    {77, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<BluetoothGATTWriteDescriptorRequest,
+                    &APIServerConnectionBase::on_bluetooth_gatt_write_descriptor_request>},
 #endif
-      this->on_bluetooth_gatt_write_descriptor_request(msg);
-#endif
-      break;
-    }
-    case 78: {
 #ifdef USE_BLUETOOTH_PROXY
-      BluetoothGATTNotifyRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_bluetooth_gatt_notify_request: %s", msg.dump().c_str());
+    {78, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<BluetoothGATTNotifyRequest, &APIServerConnectionBase::on_bluetooth_gatt_notify_request>},
 #endif
-      this->on_bluetooth_gatt_notify_request(msg);
-#endif
-      break;
-    }
-    case 80: {
 #ifdef USE_BLUETOOTH_PROXY
-      SubscribeBluetoothConnectionsFreeRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_subscribe_bluetooth_connections_free_request: %s", msg.dump().c_str());
-#endif
-      this->on_subscribe_bluetooth_connections_free_request(msg);
+    {80, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SubscribeBluetoothConnectionsFreeRequest,
+                    &APIServerConnectionBase::on_subscribe_bluetooth_connections_free_request>},
 #endif
-      break;
-    }
-    case 87: {
 #ifdef USE_BLUETOOTH_PROXY
-      UnsubscribeBluetoothLEAdvertisementsRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_unsubscribe_bluetooth_le_advertisements_request: %s", msg.dump().c_str());
-#endif
-      this->on_unsubscribe_bluetooth_le_advertisements_request(msg);
+    {87, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<UnsubscribeBluetoothLEAdvertisementsRequest,
+                    &APIServerConnectionBase::on_unsubscribe_bluetooth_le_advertisements_request>},
 #endif
-      break;
-    }
-    case 89: {
 #ifdef USE_VOICE_ASSISTANT
-      SubscribeVoiceAssistantRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_subscribe_voice_assistant_request: %s", msg.dump().c_str());
-#endif
-      this->on_subscribe_voice_assistant_request(msg);
+    {89, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<SubscribeVoiceAssistantRequest, &APIServerConnectionBase::on_subscribe_voice_assistant_request>},
 #endif
-      break;
-    }
-    case 91: {
 #ifdef USE_VOICE_ASSISTANT
-      VoiceAssistantResponse msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_voice_assistant_response: %s", msg.dump().c_str());
-#endif
-      this->on_voice_assistant_response(msg);
+    {91, 0, handle_message<VoiceAssistantResponse, &APIServerConnectionBase::on_voice_assistant_response>},
 #endif
-      break;
-    }
-    case 92: {
 #ifdef USE_VOICE_ASSISTANT
-      VoiceAssistantEventResponse msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_voice_assistant_event_response: %s", msg.dump().c_str());
+    {92, 0, handle_message<VoiceAssistantEventResponse, &APIServerConnectionBase::on_voice_assistant_event_response>},
 #endif
-      this->on_voice_assistant_event_response(msg);
-#endif
-      break;
-    }
-    case 96: {
 #ifdef USE_ALARM_CONTROL_PANEL
-      AlarmControlPanelCommandRequest msg;
-      msg.decode(msg_data, msg_size);
-#ifdef HAS_PROTO_MESSAGE_DUMP
-      ESP_LOGVV(TAG, "on_alarm_control_panel_command_request: %s", msg.dump().c_str());
+    {96, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<AlarmControlPanelCommandRequest, &APIServerConnectionBase::on_alarm_control_panel_command_request>},
 #endif
-      this->on_alarm_control_panel_command_request(msg);
+#ifdef USE_COMPONENT_PROFILER
+    {97, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<ComponentProfileRequest, &APIServerConnectionBase::on_component_profile_request>},
 #endif
-      break;
-    }
-    default:
-      return false;
+#ifdef USE_API_CONNECTION_STATS
+    {100, NEEDS_SETUP_CONNECTION | NEEDS_AUTHENTICATION,
+     handle_message<ConnectionStatsRequest, &APIServerConnectionBase::on_connection_stats_request>},
+#endif
+};
+
+bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
+  const MessageHandler *end = MESSAGE_HANDLERS + sizeof(MESSAGE_HANDLERS) / sizeof(MESSAGE_HANDLERS[0]);
+  const MessageHandler *handler = std::lower_bound(
+      MESSAGE_HANDLERS, end, msg_type, [](const MessageHandler &h, uint32_t type) { return h.msg_type < type; });
+  if (handler == end || handler->msg_type != msg_type) {
+    ESP_LOGV(TAG, "Ignoring unknown message type %" PRIu32, msg_type);
+    return false;
+  }
+  if ((handler->requirements & NEEDS_SETUP_CONNECTION) && !this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return true;
+  }
+  if ((handler->requirements & NEEDS_AUTHENTICATION) && !this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return true;
   }
+  handler->handle(this, msg_data, msg_size);
   return true;
 }
 
@@ -947,351 +729,109 @@ void APIServerConnection::on_ping_request(const PingRequest &msg) {
   }
 }
 void APIServerConnection::on_device_info_request(const DeviceInfoRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
   DeviceInfoResponse ret = this->device_info(msg);
   if (!this->send_device_info_response(ret)) {
     this->on_fatal_error();
   }
 }
-void APIServerConnection::on_list_entities_request(const ListEntitiesRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->list_entities(msg);
-}
+void APIServerConnection::on_list_entities_request(const ListEntitiesRequest &msg) { this->list_entities(msg); }
 void APIServerConnection::on_subscribe_states_request(const SubscribeStatesRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->subscribe_states(msg);
 }
-void APIServerConnection::on_subscribe_logs_request(const SubscribeLogsRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->subscribe_logs(msg);
-}
+void APIServerConnection::on_subscribe_logs_request(const SubscribeLogsRequest &msg) { this->subscribe_logs(msg); }
 void APIServerConnection::on_subscribe_homeassistant_services_request(
     const SubscribeHomeassistantServicesRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->subscribe_homeassistant_services(msg);
 }
 void APIServerConnection::on_subscribe_home_assistant_states_request(const SubscribeHomeAssistantStatesRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->subscribe_home_assistant_states(msg);
 }
 void APIServerConnection::on_get_time_request(const GetTimeRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
   GetTimeResponse ret = this->get_time(msg);
   if (!this->send_get_time_response(ret)) {
     this->on_fatal_error();
   }
 }
-void APIServerConnection::on_execute_service_request(const ExecuteServiceRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->execute_service(msg);
-}
+void APIServerConnection::on_execute_service_request(const ExecuteServiceRequest &msg) { this->execute_service(msg); }
 #ifdef USE_COVER
-void APIServerConnection::on_cover_command_request(const CoverCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->cover_command(msg);
-}
+void APIServerConnection::on_cover_command_request(const CoverCommandRequest &msg) { this->cover_command(msg); }
 #endif
 #ifdef USE_FAN
-void APIServerConnection::on_fan_command_request(const FanCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->fan_command(msg);
-}
+void APIServerConnection::on_fan_command_request(const FanCommandRequest &msg) { this->fan_command(msg); }
 #endif
 #ifdef USE_LIGHT
-void APIServerConnection::on_light_command_request(const LightCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->light_command(msg);
-}
+void APIServerConnection::on_light_command_request(const LightCommandRequest &msg) { this->light_command(msg); }
 #endif
 #ifdef USE_SWITCH
-void APIServerConnection::on_switch_command_request(const SwitchCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->switch_command(msg);
-}
+void APIServerConnection::on_switch_command_request(const SwitchCommandRequest &msg) { this->switch_command(msg); }
 #endif
 #ifdef USE_ESP32_CAMERA
-void APIServerConnection::on_camera_image_request(const CameraImageRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->camera_image(msg);
-}
+void APIServerConnection::on_camera_image_request(const CameraImageRequest &msg) { this->camera_image(msg); }
 #endif
 #ifdef USE_CLIMATE
-void APIServerConnection::on_climate_command_request(const ClimateCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->climate_command(msg);
-}
+void APIServerConnection::on_climate_command_request(const ClimateCommandRequest &msg) { this->climate_command(msg); }
 #endif
 #ifdef USE_NUMBER
-void APIServerConnection::on_number_command_request(const NumberCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->number_command(msg);
-}
+void APIServerConnection::on_number_command_request(const NumberCommandRequest &msg) { this->number_command(msg); }
 #endif
 #ifdef USE_SELECT
-void APIServerConnection::on_select_command_request(const SelectCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->select_command(msg);
-}
+void APIServerConnection::on_select_command_request(const SelectCommandRequest &msg) { this->select_command(msg); }
 #endif
 #ifdef USE_BUTTON
-void APIServerConnection::on_button_command_request(const ButtonCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->button_command(msg);
-}
+void APIServerConnection::on_button_command_request(const ButtonCommandRequest &msg) { this->button_command(msg); }
 #endif
 #ifdef USE_LOCK
-void APIServerConnection::on_lock_command_request(const LockCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
-  this->lock_command(msg);
-}
+void APIServerConnection::on_lock_command_request(const LockCommandRequest &msg) { this->lock_command(msg); }
 #endif
 #ifdef USE_MEDIA_PLAYER
 void APIServerConnection::on_media_player_command_request(const MediaPlayerCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->media_player_command(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_subscribe_bluetooth_le_advertisements_request(
     const SubscribeBluetoothLEAdvertisementsRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->subscribe_bluetooth_le_advertisements(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_bluetooth_device_request(const BluetoothDeviceRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->bluetooth_device_request(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_bluetooth_gatt_get_services_request(const BluetoothGATTGetServicesRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->bluetooth_gatt_get_services(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_bluetooth_gatt_read_request(const BluetoothGATTReadRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->bluetooth_gatt_read(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_bluetooth_gatt_write_request(const BluetoothGATTWriteRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->bluetooth_gatt_write(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_bluetooth_gatt_read_descriptor_request(const BluetoothGATTReadDescriptorRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->bluetooth_gatt_read_descriptor(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_bluetooth_gatt_write_descriptor_request(const BluetoothGATTWriteDescriptorRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->bluetooth_gatt_write_descriptor(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_bluetooth_gatt_notify_request(const BluetoothGATTNotifyRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->bluetooth_gatt_notify(msg);
 }
 #endif
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_subscribe_bluetooth_connections_free_request(
     const SubscribeBluetoothConnectionsFreeRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   BluetoothConnectionsFreeResponse ret = this->subscribe_bluetooth_connections_free(msg);
   if (!this->send_bluetooth_connections_free_response(ret)) {
     this->on_fatal_error();
@@ -1301,41 +841,33 @@ void APIServerConnection::on_subscribe_bluetooth_connections_free_request(
 #ifdef USE_BLUETOOTH_PROXY
 void APIServerConnection::on_unsubscribe_bluetooth_le_advertisements_request(
     const UnsubscribeBluetoothLEAdvertisementsRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->unsubscribe_bluetooth_le_advertisements(msg);
 }
 #endif
 #ifdef USE_VOICE_ASSISTANT
 void APIServerConnection::on_subscribe_voice_assistant_request(const SubscribeVoiceAssistantRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
-  }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
-  }
   this->subscribe_voice_assistant(msg);
 }
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
 void APIServerConnection::on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &msg) {
-  if (!this->is_connection_setup()) {
-    this->on_no_setup_connection();
-    return;
+  this->alarm_control_panel_command(msg);
+}
+#endif
+#ifdef USE_COMPONENT_PROFILER
+void APIServerConnection::on_component_profile_request(const ComponentProfileRequest &msg) {
+  ComponentProfileResponse ret = this->component_profile(msg);
+  if (!this->send_component_profile_response(ret)) {
+    this->on_fatal_error();
   }
-  if (!this->is_authenticated()) {
-    this->on_unauthenticated_access();
-    return;
+}
+#endif
+#ifdef USE_API_CONNECTION_STATS
+void APIServerConnection::on_connection_stats_request(const ConnectionStatsRequest &msg) {
+  ConnectionStatsResponse ret = this->connection_stats(msg);
+  if (!this->send_connection_stats_response(ret)) {
+    this->on_fatal_error();
   }
-  this->alarm_control_panel_command(msg);
 }
 #endif
 
@@ -66,6 +66,9 @@ class APIServerConnectionBase : public ProtoService {
 #ifdef USE_SENSOR
   bool send_sensor_state_response(const SensorStateResponse &msg);
 #endif
+#ifdef USE_API_SENSOR_BATCH
+  bool send_batch_sensor_state_response(const BatchSensorStateResponse &msg);
+#endif
 #ifdef USE_SWITCH
   bool send_list_entities_switch_response(const ListEntitiesSwitchResponse &msg);
 #endif
@@ -248,6 +251,18 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &value){};
+#endif
+#ifdef USE_COMPONENT_PROFILER
+  virtual void on_component_profile_request(const ComponentProfileRequest &value){};
+#endif
+#ifdef USE_COMPONENT_PROFILER
+  bool send_component_profile_response(const ComponentProfileResponse &msg);
+#endif
+#ifdef USE_API_CONNECTION_STATS
+  virtual void on_connection_stats_request(const ConnectionStatsRequest &value){};
+#endif
+#ifdef USE_API_CONNECTION_STATS
+  bool send_connection_stats_response(const ConnectionStatsResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -336,6 +351,12 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) = 0;
+#endif
+#ifdef USE_COMPONENT_PROFILER
+  virtual ComponentProfileResponse component_profile(const ComponentProfileRequest &msg) = 0;
+#endif
+#ifdef USE_API_CONNECTION_STATS
+  virtual ConnectionStatsResponse connection_stats(const ConnectionStatsRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -420,6 +441,12 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_ALARM_CONTROL_PANEL
   void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &msg) override;
 #endif
+#ifdef USE_COMPONENT_PROFILER
+  void on_component_profile_request(const ComponentProfileRequest &msg) override;
+#endif
+#ifdef USE_API_CONNECTION_STATS
+  void on_connection_stats_request(const ConnectionStatsRequest &msg) override;
+#endif
 };
 
 }  // namespace api
@@ -19,6 +19,10 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api";
+static const uint32_t REBOOT_TIMEOUT_ID = fnv1_hash_static("reboot");
+#if defined(USE_API_CONNECTION_STATS) && defined(USE_SENSOR)
+static const uint32_t STATS_INTERVAL_ID = fnv1_hash_static("stats");
+#endif
 
 // APIServer
 void APIServer::setup() {
@@ -79,6 +83,19 @@ void APIServer::setup() {
 
   this->last_connected_ = millis();
 
+#if defined(USE_API_CONNECTION_STATS) && defined(USE_SENSOR)
+  if (this->bytes_sent_sensor_ != nullptr || this->bytes_received_sensor_ != nullptr ||
+      this->send_buffer_full_sensor_ != nullptr || this->dropped_states_sensor_ != nullptr ||
+      this->command_latency_sensor_ != nullptr) {
+    this->set_interval(STATS_INTERVAL_ID, this->stats_update_interval_, [this]() { this->update_stats_sensors_(); });
+  }
+#endif
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  if (App.register_socket_fd(this->socket_->get_fd()))
+    this->accept_wakes_loop_ = App.set_socket_wake_component(this->socket_->get_fd(), this);
+#endif
+
 #ifdef USE_ESP32_CAMERA
   if (esp32_camera::global_esp32_camera != nullptr && !esp32_camera::global_esp32_camera->is_internal()) {
     esp32_camera::global_esp32_camera->add_image_callback(
@@ -100,10 +117,16 @@ void APIServer::loop() {
     if (!sock)
       break;
     ESP_LOGD(TAG, "Accepted %s", sock->getpeername().c_str());
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    // The connection reads its socket in every loop(), unregistered again when it closes the socket
+    App.register_socket_fd(sock->get_fd());
+#endif
 
     auto *conn = new APIConnection(std::move(sock), this);
     clients_.emplace_back(conn);
     conn->start();
+    if (this->accept_wakes_loop_)
+      this->cancel_timeout(REBOOT_TIMEOUT_ID);
   }
 
   // Partition clients into remove and active
@@ -112,6 +135,9 @@ void APIServer::loop() {
   // print disconnection messages
   for (auto it = new_end; it != this->clients_.end(); ++it) {
     ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
+#ifdef USE_API_CONNECTION_STATS
+    this->closed_stats_.add((*it)->get_stats());
+#endif
   }
   // resize vector
   this->clients_.erase(new_end, this->clients_.end());
@@ -133,6 +159,20 @@ void APIServer::loop() {
       this->status_clear_warning();
     }
   }
+
+  if (this->clients_.empty() && this->accept_wakes_loop_) {
+    // Nothing to do until a client connects, which re-enables the loop. The reboot timeout check above can't run
+    // meanwhile, so hand it over to the scheduler.
+    if (this->reboot_timeout_ != 0) {
+      const uint32_t elapsed = millis() - this->last_connected_;
+      const uint32_t remaining = elapsed < this->reboot_timeout_ ? this->reboot_timeout_ - elapsed : 0;
+      this->set_timeout(REBOOT_TIMEOUT_ID, remaining, []() {
+        ESP_LOGE(TAG, "No client connected to API. Rebooting...");
+        App.reboot();
+      });
+    }
+    this->disable_loop();
+  }
 }
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
@@ -143,6 +183,46 @@ void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "  Using noise encryption: NO");
 #endif
 }
+#ifdef USE_API_CONNECTION_STATS
+void APIConnectionStats::add(const APIConnectionStats &other) {
+  this->messages_received += other.messages_received;
+  this->bytes_received += other.bytes_received;
+  this->messages_sent += other.messages_sent;
+  this->bytes_sent += other.bytes_sent;
+  this->send_buffer_full += other.send_buffer_full;
+  this->deferred_states += other.deferred_states;
+  this->dropped_states += other.dropped_states;
+  this->command_count += other.command_count;
+  this->command_latency_us += other.command_latency_us;
+  this->command_latency_max_us = std::max(this->command_latency_max_us, other.command_latency_max_us);
+}
+APIConnectionStats APIServer::get_total_stats() const {
+  APIConnectionStats total = this->closed_stats_;
+  for (const auto &client : this->clients_)
+    total.add(client->get_stats());
+  return total;
+}
+#ifdef USE_SENSOR
+void APIServer::update_stats_sensors_() {
+  const APIConnectionStats total = this->get_total_stats();
+  if (this->bytes_sent_sensor_ != nullptr)
+    this->bytes_sent_sensor_->publish_state(total.bytes_sent);
+  if (this->bytes_received_sensor_ != nullptr)
+    this->bytes_received_sensor_->publish_state(total.bytes_received);
+  if (this->send_buffer_full_sensor_ != nullptr)
+    this->send_buffer_full_sensor_->publish_state(total.send_buffer_full);
+  if (this->dropped_states_sensor_ != nullptr)
+    this->dropped_states_sensor_->publish_state(total.dropped_states);
+  if (this->command_latency_sensor_ != nullptr && total.command_count != this->last_command_count_) {
+    const uint64_t latency_us = total.command_latency_us - this->last_command_latency_us_;
+    const uint32_t commands = total.command_count - this->last_command_count_;
+    this->command_latency_sensor_->publish_state(latency_us / 1000.0f / commands);
+  }
+  this->last_command_count_ = total.command_count;
+  this->last_command_latency_us_ = total.command_latency_us;
+}
+#endif
+#endif
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
   // depend only on input password length
@@ -178,7 +258,7 @@ void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_binary_sensor_state(obj, state);
+    c->send_state_update<binary_sensor::BinarySensor, &InitialStateIterator::on_binary_sensor>(obj);
 }
 #endif
 
@@ -187,7 +267,7 @@ void APIServer::on_cover_update(cover::Cover *obj) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_cover_state(obj);
+    c->send_state_update<cover::Cover, &InitialStateIterator::on_cover>(obj);
 }
 #endif
 
@@ -196,7 +276,7 @@ void APIServer::on_fan_update(fan::Fan *obj) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_fan_state(obj);
+    c->send_state_update<fan::Fan, &InitialStateIterator::on_fan>(obj);
 }
 #endif
 
@@ -205,7 +285,7 @@ void APIServer::on_light_update(light::LightState *obj) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_light_state(obj);
+    c->send_state_update<light::LightState, &InitialStateIterator::on_light>(obj);
 }
 #endif
 
@@ -213,8 +293,13 @@ void APIServer::on_light_update(light::LightState *obj) {
 void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
   if (obj->is_internal())
     return;
-  for (auto &c : this->clients_)
-    c->send_sensor_state(obj, state);
+  for (auto &c : this->clients_) {
+#ifdef USE_API_SENSOR_BATCH
+    if (c->add_sensor_to_batch(obj))
+      continue;
+#endif
+    c->send_state_update<sensor::Sensor, &InitialStateIterator::on_sensor>(obj);
+  }
 }
 #endif
 
@@ -223,7 +308,7 @@ void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_switch_state(obj, state);
+    c->send_state_update<switch_::Switch, &InitialStateIterator::on_switch>(obj);
 }
 #endif
 
@@ -232,7 +317,7 @@ void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::s
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_text_sensor_state(obj, state);
+    c->send_state_update<text_sensor::TextSensor, &InitialStateIterator::on_text_sensor>(obj);
 }
 #endif
 
@@ -241,7 +326,7 @@ void APIServer::on_climate_update(climate::Climate *obj) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_climate_state(obj);
+    c->send_state_update<climate::Climate, &InitialStateIterator::on_climate>(obj);
 }
 #endif
 
@@ -250,7 +335,7 @@ void APIServer::on_number_update(number::Number *obj, float state) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_number_state(obj, state);
+    c->send_state_update<number::Number, &InitialStateIterator::on_number>(obj);
 }
 #endif
 
@@ -259,7 +344,7 @@ void APIServer::on_select_update(select::Select *obj, const std::string &state,
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_select_state(obj, state);
+    c->send_state_update<select::Select, &InitialStateIterator::on_select>(obj);
 }
 #endif
 
@@ -268,7 +353,7 @@ void APIServer::on_lock_update(lock::Lock *obj) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_lock_state(obj, obj->state);
+    c->send_state_update<lock::Lock, &InitialStateIterator::on_lock>(obj);
 }
 #endif
 
@@ -277,7 +362,7 @@ void APIServer::on_media_player_update(media_player::MediaPlayer *obj) {
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_media_player_state(obj);
+    c->send_state_update<media_player::MediaPlayer, &InitialStateIterator::on_media_player>(obj);
 }
 #endif
 
@@ -343,7 +428,7 @@ void APIServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlP
   if (obj->is_internal())
     return;
   for (auto &c : this->clients_)
-    c->send_alarm_control_panel_state(obj);
+    c->send_state_update<alarm_control_panel::AlarmControlPanel, &InitialStateIterator::on_alarm_control_panel>(obj);
 }
 #endif
 
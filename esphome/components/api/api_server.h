@@ -17,6 +17,37 @@
 namespace esphome {
 namespace api {
 
+#ifdef USE_API_CONNECTION_STATS
+/// Traffic of one message type on a connection, counting the bytes of the encoded messages without their frame.
+struct APIMessageStats {
+  uint32_t type;
+  uint32_t messages_received;
+  uint32_t bytes_received;
+  uint32_t messages_sent;
+  uint32_t bytes_sent;
+};
+
+/// Traffic and latency counters of a connection, or of all connections together.
+struct APIConnectionStats {
+  uint32_t messages_received{0};
+  uint64_t bytes_received{0};
+  uint32_t messages_sent{0};
+  uint64_t bytes_sent{0};
+  /// Messages that could not be written because the send buffer was full.
+  uint32_t send_buffer_full{0};
+  /// State updates queued until the send buffer had room.
+  uint32_t deferred_states{0};
+  /// State updates never sent because a newer state of the same entity replaced them.
+  uint32_t dropped_states{0};
+  /// Commands followed by a state update of their entity, and the time until that update was sent.
+  uint32_t command_count{0};
+  uint64_t command_latency_us{0};
+  uint32_t command_latency_max_us{0};
+
+  void add(const APIConnectionStats &other);
+};
+#endif
+
 class APIServer : public Component, public Controller {
  public:
   APIServer();
@@ -31,6 +62,26 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  void set_tx_buffer_size(size_t tx_buffer_size) { tx_buffer_size_ = tx_buffer_size; }
+  size_t get_tx_buffer_size() const { return tx_buffer_size_; }
+#ifdef USE_API_SENSOR_BATCH
+  void set_sensor_batch_interval(uint32_t sensor_batch_interval) { sensor_batch_interval_ = sensor_batch_interval; }
+  uint32_t get_sensor_batch_interval() const { return sensor_batch_interval_; }
+#endif
+
+#ifdef USE_API_CONNECTION_STATS
+  /// Counters of all connections since boot, including the closed ones.
+  APIConnectionStats get_total_stats() const;
+  const std::vector<std::unique_ptr<APIConnection>> &get_clients() const { return this->clients_; }
+#ifdef USE_SENSOR
+  void set_stats_update_interval(uint32_t update_interval) { this->stats_update_interval_ = update_interval; }
+  void set_bytes_sent_sensor(sensor::Sensor *sensor) { this->bytes_sent_sensor_ = sensor; }
+  void set_bytes_received_sensor(sensor::Sensor *sensor) { this->bytes_received_sensor_ = sensor; }
+  void set_send_buffer_full_sensor(sensor::Sensor *sensor) { this->send_buffer_full_sensor_ = sensor; }
+  void set_dropped_states_sensor(sensor::Sensor *sensor) { this->dropped_states_sensor_ = sensor; }
+  void set_command_latency_sensor(sensor::Sensor *sensor) { this->command_latency_sensor_ = sensor; }
+#endif
+#endif
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -106,11 +157,34 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  size_t tx_buffer_size_{4096};
+#ifdef USE_API_SENSOR_BATCH
+  uint32_t sensor_batch_interval_{1000};
+#endif
   uint32_t last_connected_{0};
+  /// Whether a connection attempt on socket_ re-enables loop(), so the loop can be disabled while there are no clients.
+  bool accept_wakes_loop_{false};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
   std::vector<UserServiceDescriptor *> user_services_;
+#ifdef USE_API_CONNECTION_STATS
+  /// Counters of the connections that were closed.
+  APIConnectionStats closed_stats_;
+#ifdef USE_SENSOR
+  void update_stats_sensors_();
+
+  uint32_t stats_update_interval_{60000};
+  sensor::Sensor *bytes_sent_sensor_{nullptr};
+  sensor::Sensor *bytes_received_sensor_{nullptr};
+  sensor::Sensor *send_buffer_full_sensor_{nullptr};
+  sensor::Sensor *dropped_states_sensor_{nullptr};
+  sensor::Sensor *command_latency_sensor_{nullptr};
+  /// Totals at the last sensor update, the latency sensor reports the average of the commands since then.
+  uint32_t last_command_count_{0};
+  uint64_t last_command_latency_us_{0};
+#endif
+#endif
 
 #ifdef USE_API_NOISE
   std::shared_ptr<APINoiseContext> noise_ctx_ = std::make_shared<APINoiseContext>();
@@ -1,5 +1,6 @@
 import asyncio
 import logging
+import struct
 from datetime import datetime
 from typing import Optional
 
@@ -12,6 +13,58 @@ from . import CONF_ENCRYPTION
 
 _LOGGER = logging.getLogger(__name__)
 
+BATCH_SENSOR_STATE_RESPONSE_TYPE = 99
+
+
+def _read_varint(data: bytes, pos: int) -> tuple[int, int]:
+    result = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        result |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return result, pos
+        shift += 7
+
+
+def decode_batch_sensor_state(data: bytes) -> dict[int, float]:
+    """Reference decoder for the payload of a BatchSensorStateResponse.
+
+    Returns the states by sensor key. Both the packed encoding the server uses
+    and the unpacked one are accepted, as protobuf requires.
+    """
+    keys: list[int] = []
+    states: list[float] = []
+    pos = 0
+    while pos < len(data):
+        tag, pos = _read_varint(data, pos)
+        field, wire_type = tag >> 3, tag & 0x7
+        if wire_type == 2:
+            length, pos = _read_varint(data, pos)
+            value = data[pos : pos + length]
+            pos += length
+            if field == 1:
+                keys.extend(struct.unpack(f"<{length // 4}I", value))
+            elif field == 2:
+                states.extend(struct.unpack(f"<{length // 4}f", value))
+        elif wire_type == 5:
+            value = data[pos : pos + 4]
+            pos += 4
+            if field == 1:
+                keys.append(struct.unpack("<I", value)[0])
+            elif field == 2:
+                states.append(struct.unpack("<f", value)[0])
+        elif wire_type == 0:
+            _, pos = _read_varint(data, pos)
+        elif wire_type == 1:
+            pos += 8
+        else:
+            raise ValueError(f"Unsupported wire type {wire_type}")
+    if len(keys) != len(states):
+        raise ValueError(f"Got {len(keys)} keys but {len(states)} states")
+    return dict(zip(keys, states))
+
 
 async def async_run_logs(config, address):
     conf = config["api"]
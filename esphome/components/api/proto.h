@@ -3,7 +3,9 @@
 #include "esphome/core/component.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
+#include <cstring>
 #include <vector>
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
@@ -96,11 +98,23 @@ class ProtoLengthDelimited {
  public:
   explicit ProtoLengthDelimited(const uint8_t *value, size_t length) : value_(value), length_(length) {}
   std::string as_string() const { return std::string(reinterpret_cast<const char *>(this->value_), this->length_); }
+  /// View of the value in the receive buffer, only valid as long as that buffer is.
+  StringRef as_string_ref() const { return StringRef(this->value_, this->length_); }
   template<class C> C as_message() const {
     auto msg = C();
     msg.decode(this->value_, this->length_);
     return msg;
   }
+  /// Append the values of a packed repeated field of 32 bit values (fixed32, sfixed32 or float) to out.
+  template<typename T> void as_packed_32bit(std::vector<T> &out) const {
+    static_assert(sizeof(T) == 4, "packed field must have 32 bit values");
+    for (size_t i = 0; i + 4 <= this->length_; i += 4) {
+      uint32_t raw = encode_uint32(this->value_[i + 3], this->value_[i + 2], this->value_[i + 1], this->value_[i]);
+      T value;
+      memcpy(&value, &raw, sizeof(value));
+      out.push_back(value);
+    }
+  }
 
  protected:
   const uint8_t *const value_;
@@ -143,6 +157,116 @@ class Proto64Bit {
   const uint64_t value_;
 };
 
+/** Computes the encoded size of message fields, matching what ProtoWriteBuffer writes for them.
+ *
+ * Used by the generated calculate_size() methods, so that encoding can reserve the buffer once and write the length
+ * of nested messages in front of them without moving the encoded data. The field_id_size arguments are the size of
+ * the field tag, which the generator computes ahead of time.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) {
+    uint32_t size = 1;
+    while (value > 0x7F) {
+      value >>= 7;
+      size++;
+    }
+    return size;
+  }
+  static uint32_t varint(uint64_t value) {
+    uint32_t size = 1;
+    while (value > 0x7F) {
+      value >>= 7;
+      size++;
+    }
+    return size;
+  }
+
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      add_int64_field(total_size, field_id_size, value, force);
+      return;
+    }
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id_size, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force = false) {
+    add_uint32_field(total_size, field_id_size, value < 0 ? ~(value << 1) : value << 1, force);
+  }
+  static void add_sint64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id_size, value < 0 ? ~(value << 1) : value << 1, force);
+  }
+  template<typename T>
+  static void add_enum_field(uint32_t &total_size, uint32_t field_id_size, T value, bool force = false) {
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id_size, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field_id_size + 1;
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 4;
+  }
+  static void add_fixed64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 8;
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id_size, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    union {
+      float value;
+      uint32_t raw;
+    } val{};
+    val.value = value;
+    // encode_float() passes the raw value on without force
+    add_fixed32_field(total_size, field_id_size, val.raw);
+  }
+  template<typename T>
+  static void add_packed_32bit_field(uint32_t &total_size, uint32_t field_id_size, const std::vector<T> &values) {
+    if (values.empty())
+      return;
+    const uint32_t len = values.size() * 4;
+    total_size += field_id_size + varint(len) + len;
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id_size, const std::string &value,
+                               bool force = false) {
+    // encode_string() skips empty strings even with force
+    if (value.empty())
+      return;
+    total_size += field_id_size + varint(static_cast<uint32_t>(value.size())) + value.size();
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id_size, const StringRef &value,
+                               bool force = false) {
+    if (value.empty() && !force)
+      return;
+    total_size += field_id_size + varint(static_cast<uint32_t>(value.size())) + value.size();
+  }
+  template<class C>
+  static void add_message_field(uint32_t &total_size, uint32_t field_id_size, const C &value, bool force = false) {
+    uint32_t nested_size = 0;
+    value.calculate_size(nested_size);
+    total_size += field_id_size + varint(nested_size) + nested_size;
+  }
+};
+
 class ProtoWriteBuffer {
  public:
   ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
@@ -166,6 +290,9 @@ class ProtoWriteBuffer {
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
     this->encode_string(field_id, value.data(), value.size());
   }
+  void encode_string(uint32_t field_id, const StringRef &ref, bool force = false) {
+    this->encode_string(field_id, ref.c_str(), ref.size(), force);
+  }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
   }
@@ -197,6 +324,23 @@ class ProtoWriteBuffer {
     this->write((value >> 16) & 0xFF);
     this->write((value >> 24) & 0xFF);
   }
+  /// Encode a packed repeated field of 32 bit values (fixed32, sfixed32 or float), one length prefix for all values.
+  template<typename T> void encode_packed_32bit(uint32_t field_id, const std::vector<T> &values) {
+    static_assert(sizeof(T) == 4, "packed field must have 32 bit values");
+    if (values.empty())
+      return;
+
+    this->encode_field_raw(field_id, 2);
+    this->encode_varint_raw(static_cast<uint32_t>(values.size() * 4));
+    for (const T &value : values) {
+      uint32_t raw;
+      memcpy(&raw, &value, sizeof(raw));
+      this->write((raw >> 0) & 0xFF);
+      this->write((raw >> 8) & 0xFF);
+      this->write((raw >> 16) & 0xFF);
+      this->write((raw >> 24) & 0xFF);
+    }
+  }
   void encode_fixed64(uint32_t field_id, uint64_t value, bool force = false) {
     if (value == 0 && !force)
       return;
@@ -256,15 +400,10 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -276,6 +415,8 @@ class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the size of the encoded message to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -304,7 +445,10 @@ class ProtoService {
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
     auto buffer = this->create_buffer();
+    buffer.get_buffer()->reserve(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -0,0 +1,81 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    CONF_UPDATE_INTERVAL,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_BYTES,
+    UNIT_MILLISECOND,
+)
+from . import APIServer
+
+DEPENDENCIES = ["api"]
+
+CONF_BYTES_SENT = "bytes_sent"
+CONF_BYTES_RECEIVED = "bytes_received"
+CONF_SEND_BUFFER_FULL = "send_buffer_full"
+CONF_DROPPED_STATES = "dropped_states"
+CONF_COMMAND_LATENCY = "command_latency"
+
+COUNTER_SCHEMA = sensor.sensor_schema(
+    icon=ICON_COUNTER,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+BYTES_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_BYTES,
+    icon=ICON_COUNTER,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CONFIG_SCHEMA = {
+    cv.GenerateID(): cv.use_id(APIServer),
+    cv.Optional(
+        CONF_UPDATE_INTERVAL, default="60s"
+    ): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_BYTES_SENT): BYTES_SCHEMA,
+    cv.Optional(CONF_BYTES_RECEIVED): BYTES_SCHEMA,
+    cv.Optional(CONF_SEND_BUFFER_FULL): COUNTER_SCHEMA,
+    cv.Optional(CONF_DROPPED_STATES): COUNTER_SCHEMA,
+    cv.Optional(CONF_COMMAND_LATENCY): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=1,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+}
+
+
+async def to_code(config):
+    server = await cg.get_variable(config[CONF_ID])
+    cg.add(server.set_stats_update_interval(config[CONF_UPDATE_INTERVAL]))
+    cg.add_define("USE_API_CONNECTION_STATS")
+
+    if CONF_BYTES_SENT in config:
+        sens = await sensor.new_sensor(config[CONF_BYTES_SENT])
+        cg.add(server.set_bytes_sent_sensor(sens))
+
+    if CONF_BYTES_RECEIVED in config:
+        sens = await sensor.new_sensor(config[CONF_BYTES_RECEIVED])
+        cg.add(server.set_bytes_received_sensor(sens))
+
+    if CONF_SEND_BUFFER_FULL in config:
+        sens = await sensor.new_sensor(config[CONF_SEND_BUFFER_FULL])
+        cg.add(server.set_send_buffer_full_sensor(sens))
+
+    if CONF_DROPPED_STATES in config:
+        sens = await sensor.new_sensor(config[CONF_DROPPED_STATES])
+        cg.add(server.set_dropped_states_sensor(sens))
+
+    if CONF_COMMAND_LATENCY in config:
+        sens = await sensor.new_sensor(config[CONF_COMMAND_LATENCY])
+        cg.add(server.set_command_latency_sensor(sens))
@@ -33,50 +33,72 @@ void DallasComponent::setup() {
 
   pin_->setup();
 
-  // clear bus with 480µs high, otherwise initial reset in search_vec() fails
+  // clear bus with 480µs high, otherwise the initial reset of the first search fails
   pin_->pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
   delayMicroseconds(480);
 
   one_wire_ = new ESPOneWire(pin_);  // NOLINT(cppcoreguidelines-owning-memory)
 
-  std::vector<uint64_t> raw_sensors;
-  raw_sensors = this->one_wire_->search_vec();
+  // Searching the bus takes around 14 ms per device and configuring a sensor's resolution another 20 ms, so do it one
+  // step per loop iteration instead of holding back the setup of all following components
+  this->begin_async_setup_();
+  this->one_wire_->reset_search();
+  this->set_timeout(0, [this]() { this->search_next_(); });
+}
+void DallasComponent::search_next_() {
+  uint64_t address = this->one_wire_->search();
+  if (address == 0u) {
+    this->setup_sensor_(0);
+    return;
+  }
 
-  for (auto &address : raw_sensors) {
-    auto *address8 = reinterpret_cast<uint8_t *>(&address);
-    if (crc8(address8, 7) != address8[7]) {
-      ESP_LOGW(TAG, "Dallas device 0x%s has invalid CRC.", format_hex(address).c_str());
-      continue;
-    }
-    if (address8[0] != DALLAS_MODEL_DS18S20 && address8[0] != DALLAS_MODEL_DS1822 &&
-        address8[0] != DALLAS_MODEL_DS18B20 && address8[0] != DALLAS_MODEL_DS1825 &&
-        address8[0] != DALLAS_MODEL_DS28EA00) {
-      ESP_LOGW(TAG, "Unknown device type 0x%02X.", address8[0]);
-      continue;
-    }
+  auto *address8 = reinterpret_cast<uint8_t *>(&address);
+  if (crc8(address8, 7) != address8[7]) {
+    ESP_LOGW(TAG, "Dallas device 0x%s has invalid CRC.", format_hex(address).c_str());
+  } else if (address8[0] != DALLAS_MODEL_DS18S20 && address8[0] != DALLAS_MODEL_DS1822 &&
+             address8[0] != DALLAS_MODEL_DS18B20 && address8[0] != DALLAS_MODEL_DS1825 &&
+             address8[0] != DALLAS_MODEL_DS28EA00) {
+    ESP_LOGW(TAG, "Unknown device type 0x%02X.", address8[0]);
+  } else {
     this->found_sensors_.push_back(address);
   }
+  this->set_timeout(0, [this]() { this->search_next_(); });
+}
+void DallasComponent::setup_sensor_(size_t index) {
+  if (index >= this->sensors_.size()) {
+    this->complete_async_setup_();
+    return;
+  }
 
-  for (auto *sensor : this->sensors_) {
-    if (sensor->get_index().has_value()) {
-      if (*sensor->get_index() >= this->found_sensors_.size()) {
-        this->status_set_error();
-        continue;
-      }
-      sensor->set_address(this->found_sensors_[*sensor->get_index()]);
-    }
-
-    if (!sensor->setup_sensor()) {
+  auto *sensor = this->sensors_[index];
+  if (sensor->get_index().has_value()) {
+    if (*sensor->get_index() >= this->found_sensors_.size()) {
       this->status_set_error();
+      this->set_timeout(0, [this, index]() { this->setup_sensor_(index + 1); });
+      return;
     }
+    sensor->set_address(this->found_sensors_[*sensor->get_index()]);
   }
+
+  if (!sensor->setup_sensor()) {
+    this->status_set_error();
+    this->set_timeout(0, [this, index]() { this->setup_sensor_(index + 1); });
+    return;
+  }
+  // The sensor is copying its new resolution to EEPROM
+  this->set_timeout(20, [this, index]() {
+    this->one_wire_->reset();
+    this->setup_sensor_(index + 1);
+  });
 }
 void DallasComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "DallasComponent:");
   LOG_PIN("  Pin: ", this->pin_);
   LOG_UPDATE_INTERVAL(this);
 
-  if (this->found_sensors_.empty()) {
+  if (this->is_setup_pending()) {
+    ESP_LOGCONFIG(TAG, "  Still searching for sensors...");
+  } else if (this->found_sensors_.empty()) {
     ESP_LOGW(TAG, "  Found no sensors!");
   } else {
     ESP_LOGD(TAG, "  Found sensors:");
@@ -89,6 +111,8 @@ void DallasComponent::dump_config() {
     LOG_SENSOR("  ", "Device", sensor);
     if (sensor->get_index().has_value()) {
       ESP_LOGCONFIG(TAG, "    Index %u", *sensor->get_index());
+      if (this->is_setup_pending())
+        continue;
       if (*sensor->get_index() >= this->found_sensors_.size()) {
         ESP_LOGE(TAG, "Couldn't find sensor by index - not connected. Proceeding without it.");
         continue;
@@ -101,6 +125,9 @@ void DallasComponent::dump_config() {
 
 void DallasComponent::register_sensor(DallasTemperatureSensor *sensor) { this->sensors_.push_back(sensor); }
 void DallasComponent::update() {
+  // Don't disturb the bus search of setup
+  if (this->is_setup_pending())
+    return;
   this->status_clear_warning();
 
   bool result;
@@ -235,8 +262,7 @@ bool DallasTemperatureSensor::setup_sensor() {
     }
   }
 
-  delay(20);  // allow it to finish operation
-  wire->reset();
+  // The caller waits 20 ms for the EEPROM write to finish and resets the bus
   return true;
 }
 bool DallasTemperatureSensor::check_scratch_pad() {
@@ -25,6 +25,11 @@ class DallasComponent : public PollingComponent {
  protected:
   friend DallasTemperatureSensor;
 
+  /// Find the next device on the bus, one per loop iteration.
+  void search_next_();
+  /// Set up the sensor at this index in sensors_ and continue with the next one.
+  void setup_sensor_(size_t index);
+
   InternalGPIOPin *pin_;
   ESPOneWire *one_wire_;
   std::vector<DallasTemperatureSensor *> sensors_;
@@ -53,6 +58,7 @@ class DallasTemperatureSensor : public sensor::Sensor {
   /// Get the number of milliseconds we have to wait for the conversion phase.
   uint16_t millis_to_wait_for_conversion() const;
 
+  /// Write the resolution to the sensor if needed. Returns true if it did, the bus needs 20 ms before it can be reset.
   bool setup_sensor();
   bool read_scratch_pad();
 
@@ -13,6 +13,7 @@ CODEOWNERS = ["@OttoWinter"]
 DEPENDENCIES = ["logger"]
 
 CONF_DEBUG_ID = "debug_id"
+CONF_PROFILER = "profiler"
 debug_ns = cg.esphome_ns.namespace("debug")
 DebugComponent = debug_ns.class_("DebugComponent", cg.PollingComponent)
 
@@ -36,6 +37,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_LOOP_TIME): cv.invalid(
                 "The 'loop_time' option has been moved to the 'debug' sensor component"
             ),
+            cv.Optional(CONF_PROFILER, default=False): cv.boolean,
         }
     ).extend(cv.polling_component_schema("60s")),
 )
@@ -44,3 +46,5 @@ CONFIG_SCHEMA = cv.All(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+    if config[CONF_PROFILER]:
+        cg.add_define("USE_COMPONENT_PROFILER")
@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -38,6 +39,11 @@ namespace debug {
 
 static const char *const TAG = "debug";
 
+#ifdef USE_COMPONENT_PROFILER
+// Number of components listed by the loop profile text sensor, keeps the state below 255 characters
+static const size_t LOOP_PROFILE_MAX_COMPONENTS = 6;
+#endif
+
 static uint32_t get_free_heap() {
 #if defined(USE_ESP8266)
   return ESP.getFreeHeap();  // NOLINT(readability-static-accessed-through-instance)
@@ -60,6 +66,9 @@ void DebugComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Debug component:");
 #ifdef USE_TEXT_SENSOR
   LOG_TEXT_SENSOR("  ", "Device info", this->device_info_);
+#ifdef USE_COMPONENT_PROFILER
+  LOG_TEXT_SENSOR("  ", "Loop profile", this->loop_profile_);
+#endif
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   LOG_SENSOR("  ", "Free space on heap", this->free_sensor_);
@@ -399,8 +408,51 @@ void DebugComponent::update() {
     this->max_loop_time_ = 0;
   }
 #endif  // USE_SENSOR
+
+#if defined(USE_TEXT_SENSOR) && defined(USE_COMPONENT_PROFILER)
+  if (this->loop_profile_ != nullptr) {
+    this->loop_profile_->publish_state(this->get_loop_profile_());
+  }
+#endif
 }
 
+#if defined(USE_TEXT_SENSOR) && defined(USE_COMPONENT_PROFILER)
+std::string DebugComponent::get_loop_profile_() {
+  const auto &components = App.get_components();
+  const uint32_t now = millis();
+  const uint64_t elapsed_us = uint64_t(now - this->last_profile_time_) * 1000;
+  this->last_profile_time_ = now;
+
+  // time spent per component since the last update
+  this->last_profile_totals_.resize(components.size());
+  std::vector<std::pair<uint64_t, Component *>> deltas;
+  deltas.reserve(components.size());
+  for (size_t i = 0; i < components.size(); i++) {
+    Component *component = components[i];
+    uint64_t total = component->get_loop_stats().total_us + component->get_scheduler_stats().total_us;
+    deltas.emplace_back(total - this->last_profile_totals_[i], component);
+    this->last_profile_totals_[i] = total;
+  }
+  std::sort(deltas.begin(), deltas.end(),
+            [](const std::pair<uint64_t, Component *> &a, const std::pair<uint64_t, Component *> &b) {
+              return a.first > b.first;
+            });
+
+  std::string profile;
+  for (size_t i = 0; i < deltas.size() && i < LOOP_PROFILE_MAX_COMPONENTS; i++) {
+    if (deltas[i].first == 0 || elapsed_us == 0)
+      break;
+    if (!profile.empty())
+      profile += ", ";
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.24s %.1f%%", deltas[i].second->get_component_source(),
+             deltas[i].first * 100.0f / elapsed_us);
+    profile += buf;
+  }
+  return profile;
+}
+#endif
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
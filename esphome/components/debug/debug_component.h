@@ -4,6 +4,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/macros.h"
 #include "esphome/core/helpers.h"
+#include <vector>
 
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
@@ -25,6 +26,9 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   void set_device_info_sensor(text_sensor::TextSensor *device_info) { device_info_ = device_info; }
   void set_reset_reason_sensor(text_sensor::TextSensor *reset_reason) { reset_reason_ = reset_reason; }
+#ifdef USE_COMPONENT_PROFILER
+  void set_loop_profile_sensor(text_sensor::TextSensor *loop_profile) { loop_profile_ = loop_profile; }
+#endif
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   void set_free_sensor(sensor::Sensor *free_sensor) { free_sensor_ = free_sensor; }
@@ -52,6 +56,14 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *device_info_{nullptr};
   text_sensor::TextSensor *reset_reason_{nullptr};
+#ifdef USE_COMPONENT_PROFILER
+  /// Summarize which components used the most time since the last call.
+  std::string get_loop_profile_();
+
+  text_sensor::TextSensor *loop_profile_{nullptr};
+  std::vector<uint64_t> last_profile_totals_{};
+  uint32_t last_profile_time_{0};
+#endif
 #endif  // USE_TEXT_SENSOR
 };
 
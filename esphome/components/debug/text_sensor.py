@@ -6,6 +6,7 @@ from esphome.const import (
     ENTITY_CATEGORY_DIAGNOSTIC,
     ICON_CHIP,
     ICON_RESTART,
+    ICON_TIMER,
 )
 
 from . import CONF_DEBUG_ID, DebugComponent
@@ -14,6 +15,7 @@ DEPENDENCIES = ["debug"]
 
 
 CONF_RESET_REASON = "reset_reason"
+CONF_LOOP_PROFILE = "loop_profile"
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -25,6 +27,10 @@ CONFIG_SCHEMA = cv.Schema(
             icon=ICON_RESTART,
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
         ),
+        cv.Optional(CONF_LOOP_PROFILE): text_sensor.text_sensor_schema(
+            icon=ICON_TIMER,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
     }
 )
 
@@ -38,3 +44,7 @@ async def to_code(config):
     if CONF_RESET_REASON in config:
         sens = await text_sensor.new_text_sensor(config[CONF_RESET_REASON])
         cg.add(debug_component.set_reset_reason_sensor(sens))
+    if CONF_LOOP_PROFILE in config:
+        cg.add_define("USE_COMPONENT_PROFILER")
+        sens = await text_sensor.new_text_sensor(config[CONF_LOOP_PROFILE])
+        cg.add(debug_component.set_loop_profile_sensor(sens))
@@ -1,5 +1,6 @@
 #include "e131.h"
 #include "e131_addressable_light_effect.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -48,6 +49,9 @@ void E131Component::setup() {
     this->mark_failed();
     return;
   }
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  App.register_socket_fd(this->socket_->get_fd());
+#endif
 
   join_igmp_groups_();
 }
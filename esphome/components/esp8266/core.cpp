@@ -12,6 +12,7 @@ namespace esphome {
 
 void IRAM_ATTR HOT yield() { ::yield(); }
 uint32_t IRAM_ATTR HOT millis() { return ::millis(); }
+uint64_t IRAM_ATTR HOT millis_64() { return ::micros64() / 1000ULL; }
 void IRAM_ATTR HOT delay(uint32_t ms) { ::delay(ms); }
 uint32_t IRAM_ATTR HOT micros() { return ::micros(); }
 void IRAM_ATTR HOT delayMicroseconds(uint32_t us) { delay_microseconds_safe(us); }
@@ -15,7 +15,7 @@ from .gpio import host_pin_to_code  # noqa
 
 
 CODEOWNERS = ["@esphome/core"]
-AUTO_LOAD = ["network"]
+AUTO_LOAD = ["network", "preferences"]
 
 
 def set_core_data(config):
@@ -0,0 +1,64 @@
+#ifdef USE_HOST
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "core.h"
+
+#include <time.h>
+#include <cerrno>
+#include <cmath>
+
+namespace esphome {
+namespace host {
+
+// The virtual clock runs at time_scale from clock_origin_ns on, and clock_offset_ns ahead of real time at that point.
+static double time_scale = 1.0;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint64_t clock_origin_ns = 0;    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint64_t clock_offset_ns = 0;    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static uint64_t real_time_ns() {
+  struct timespec spec;
+  clock_gettime(CLOCK_MONOTONIC, &spec);
+  return ((uint64_t) spec.tv_sec) * 1000000000ULL + spec.tv_nsec;
+}
+static uint64_t virtual_time_ns() {
+  uint64_t now = real_time_ns();
+  if (time_scale == 1.0)
+    return now + clock_offset_ns;
+  return clock_origin_ns + clock_offset_ns + (uint64_t) ((now - clock_origin_ns) * time_scale);
+}
+void set_time_scale(double scale) {
+  // Continue from the current virtual time, the clock must never jump back
+  const uint64_t now = real_time_ns();
+  const uint64_t virtual_now = virtual_time_ns();
+  clock_origin_ns = now;
+  clock_offset_ns = virtual_now - now;
+  time_scale = scale;
+}
+void advance_clock(uint64_t ms) { clock_offset_ns += ms * 1000000ULL; }
+uint64_t virtual_to_real_us(uint64_t virtual_us) {
+  if (time_scale == 1.0)
+    return virtual_us;
+  return (uint64_t) std::ceil(virtual_us / time_scale);
+}
+static void sleep_real_us(uint64_t us) {
+  struct timespec ts;
+  ts.tv_sec = us / 1000000ULL;
+  ts.tv_nsec = (us % 1000000ULL) * 1000ULL;
+  int res;
+  do {
+    res = nanosleep(&ts, &ts);
+  } while (res != 0 && errno == EINTR);
+}
+
+}  // namespace host
+
+uint32_t IRAM_ATTR HOT millis() { return host::virtual_time_ns() / 1000000ULL; }
+uint64_t IRAM_ATTR HOT millis_64() { return host::virtual_time_ns() / 1000000ULL; }
+void IRAM_ATTR HOT delay(uint32_t ms) { host::sleep_real_us(host::virtual_to_real_us(ms * 1000ULL)); }
+uint32_t IRAM_ATTR HOT micros() { return host::virtual_time_ns() / 1000ULL; }
+void IRAM_ATTR HOT delayMicroseconds(uint32_t us) { host::sleep_real_us(host::virtual_to_real_us(us)); }
+
+}  // namespace esphome
+
+#endif  // USE_HOST
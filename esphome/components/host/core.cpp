@@ -1,49 +1,110 @@
 #ifdef USE_HOST
 
+#include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+#include "core.h"
 #include "preferences.h"
 
+#include <getopt.h>
 #include <sched.h>
+#include <csignal>
 #include <time.h>
-#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 
 namespace esphome {
 
-void IRAM_ATTR HOT yield() { ::sched_yield(); }
-uint32_t IRAM_ATTR HOT millis() {
-  struct timespec spec;
-  clock_gettime(CLOCK_MONOTONIC, &spec);
-  time_t seconds = spec.tv_sec;
-  uint32_t ms = round(spec.tv_nsec / 1e6);
-  return ((uint32_t) seconds) * 1000U + ms;
-}
-void IRAM_ATTR HOT delay(uint32_t ms) {
-  struct timespec ts;
-  ts.tv_sec = ms / 1000;
-  ts.tv_nsec = (ms % 1000) * 1000000;
-  int res;
-  do {
-    res = nanosleep(&ts, &ts);
-  } while (res != 0 && errno == EINTR);
-}
-uint32_t IRAM_ATTR HOT micros() {
-  struct timespec spec;
-  clock_gettime(CLOCK_MONOTONIC, &spec);
-  time_t seconds = spec.tv_sec;
-  uint32_t us = round(spec.tv_nsec / 1e3);
-  return ((uint32_t) seconds) * 1000000U + us;
+namespace host {
+
+static HostOptions global_options;                // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static volatile sig_atomic_t stop_requested = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+const HostOptions &get_options() { return global_options; }
+
+static void print_usage(const char *program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  -i, --instance ID         Instance id, offsets MAC address and listening ports (default 0)\n"
+          "  -t, --time-scale FACTOR   Run the clock FACTOR times faster than real time (default 1)\n"
+          "  -c, --clock-offset MS     Start the clock MS milliseconds ahead, e.g. 4294900000 for millis() to wrap\n"
+          "                            around after about a minute (default 0)\n"
+          "  -p, --preferences FILE    Persist preferences to FILE (default <program>.<instance>.prefs)\n"
+          "  -n, --no-preferences      Keep preferences in memory only\n",
+          program);
 }
-void IRAM_ATTR HOT delayMicroseconds(uint32_t us) {
-  struct timespec ts;
-  ts.tv_sec = us / 1000000U;
-  ts.tv_nsec = (us % 1000000U) * 1000U;
-  int res;
-  do {
-    res = nanosleep(&ts, &ts);
-  } while (res != 0 && errno == EINTR);
+
+static void parse_command_line(int argc, char **argv) {
+  static const struct option LONG_OPTIONS[] = {
+      {"instance", required_argument, nullptr, 'i'},  {"time-scale", required_argument, nullptr, 't'},
+      {"clock-offset", required_argument, nullptr, 'c'}, {"preferences", required_argument, nullptr, 'p'},
+      {"no-preferences", no_argument, nullptr, 'n'},    {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0},
+  };
+  bool persist = true;
+  bool custom_path = false;
+  int opt;
+  while ((opt = getopt_long(argc, argv, "i:t:c:p:nh", LONG_OPTIONS, nullptr)) != -1) {
+    switch (opt) {
+      case 'i': {
+        auto id = parse_number<uint16_t>(optarg);
+        if (!id.has_value()) {
+          fprintf(stderr, "Invalid instance id '%s'\n", optarg);
+          exit(2);
+        }
+        global_options.instance_id = *id;
+        break;
+      }
+      case 't': {
+        auto scale = parse_number<float>(optarg);
+        if (!scale.has_value() || *scale <= 0.0f) {
+          fprintf(stderr, "Invalid time scale '%s'\n", optarg);
+          exit(2);
+        }
+        global_options.time_scale = *scale;
+        break;
+      }
+      case 'c': {
+        auto offset = parse_number<uint64_t>(optarg);
+        if (!offset.has_value()) {
+          fprintf(stderr, "Invalid clock offset '%s'\n", optarg);
+          exit(2);
+        }
+        global_options.clock_offset = *offset;
+        break;
+      }
+      case 'p':
+        global_options.preferences_path = optarg;
+        custom_path = true;
+        break;
+      case 'n':
+        persist = false;
+        break;
+      case 'h':
+        print_usage(argv[0]);
+        exit(0);
+      default:
+        print_usage(argv[0]);
+        exit(2);
+    }
+  }
+
+  if (!persist) {
+    global_options.preferences_path.clear();
+  } else if (!custom_path) {
+    global_options.preferences_path =
+        std::string(argv[0]) + "." + to_string(global_options.instance_id) + ".prefs";
+  }
+  advance_clock(global_options.clock_offset);
+  set_time_scale(global_options.time_scale);
 }
+
+static void handle_stop_signal(int signal) { stop_requested = 1; }
+
+}  // namespace host
+
+void IRAM_ATTR HOT yield() { ::sched_yield(); }
 void arch_restart() { exit(0); }
 void arch_init() {
   // pass
@@ -66,12 +127,19 @@ uint32_t arch_get_cpu_freq_hz() { return 1000000000U; }
 
 void setup();
 void loop();
-int main() {
+int main(int argc, char **argv) {
+  esphome::host::parse_command_line(argc, argv);
   esphome::host::setup_preferences();
+  // Shut down like a safe reboot on Ctrl+C/kill, so that preferences are written
+  signal(SIGINT, esphome::host::handle_stop_signal);
+  signal(SIGTERM, esphome::host::handle_stop_signal);
   setup();
-  while (true) {
+  while (!esphome::host::stop_requested) {
     loop();
   }
+  esphome::App.run_safe_shutdown_hooks();
+  esphome::global_preferences->sync();
+  return 0;
 }
 
 #endif  // USE_HOST
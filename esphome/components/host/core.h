@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+namespace host {
+
+/// Options of the host binary, set from the command line before setup() runs.
+struct HostOptions {
+  /// Distinguishes instances running side by side, offsets MAC address and listening ports.
+  uint16_t instance_id{0};
+  /// Speed of the virtual clock relative to real time, e.g. 10 runs timers ten times faster.
+  double time_scale{1.0};
+  /// Milliseconds the clock starts ahead of the system's uptime, e.g. to reach the 32-bit millis() wrap quickly.
+  uint64_t clock_offset{0};
+  /// File the preferences are persisted to, empty to keep them in memory only.
+  std::string preferences_path;
+};
+
+const HostOptions &get_options();
+
+/// Convert a duration on the virtual clock to the real time to wait for it.
+uint64_t virtual_to_real_us(uint64_t virtual_us);
+/// Run the virtual clock `scale` times faster than real time from now on, continuing from its current time.
+void set_time_scale(double scale);
+/// Fast-forward the virtual clock by `ms` milliseconds.
+void advance_clock(uint64_t ms);
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -1,8 +1,19 @@
 #ifdef USE_HOST
 
 #include "preferences.h"
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
 #include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "core.h"
 #include "esphome/core/preferences.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/defines.h"
@@ -12,18 +23,241 @@ namespace host {
 
 static const char *const TAG = "host.preferences";
 
+/// Flash is written in units of this size, like the 32 byte entries of the ESP32 NVS.
+static const size_t FLASH_WRITE_UNIT = 32;
+/// Like a flash sector, the log is only compacted once it has grown beyond this size.
+static const size_t COMPACT_MIN_SIZE = 4096;
+/// Compact the log once it is this many times larger than the live values.
+static const size_t COMPACT_RATIO = 4;
+
+struct HostPreferenceRecordHeader {
+  uint32_t type;
+  uint16_t length;
+  uint16_t crc;
+};
+
+class HostPreferences;
+
+class HostPreferenceBackend : public ESPPreferenceBackend {
+ public:
+  HostPreferenceBackend(HostPreferences *parent, uint32_t type) : parent_(parent), type_(type) {}
+
+  bool save(const uint8_t *data, size_t len) override;
+  bool load(uint8_t *data, size_t len) override;
+
+ protected:
+  HostPreferences *parent_;
+  uint32_t type_;
+};
+
+/** Preferences persisted to an append-only log file, emulating the write behaviour of flash.
+ *
+ * Like on the ESP32, save() only updates the value in memory and sync() commits the values that changed since the
+ * last sync. Every committed value is appended to the log as a record (header with type, length and CRC, followed by
+ * the data), so the log grows with every write the way flash wear does. Once the log is much larger than the live
+ * values it is compacted, which corresponds to erasing and rewriting a flash sector.
+ *
+ * The bytes written are counted in flash write units and reported on every sync, in total and per hour of (virtual)
+ * uptime, to measure the flash wear caused by a configuration.
+ */
 class HostPreferences : public ESPPreferences {
  public:
-  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override { return {}; }
+  explicit HostPreferences(std::string path) : path_(std::move(path)) {}
+
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
+    auto *backend = new HostPreferenceBackend(this, type);  // NOLINT(cppcoreguidelines-owning-memory)
+    return {backend};
+  }
+
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    return this->make_preference(length, type, false);
+  }
+
+  bool sync() override {
+    if (this->dirty_.empty() && !this->needs_compaction_)
+      return true;
+
+    size_t changed_bytes = 0;
+    for (uint32_t type : this->dirty_)
+      changed_bytes += this->values_[type].size();
+    this->sync_count_++;
+    this->changed_bytes_ += changed_bytes;
 
-  ESPPreferenceObject make_preference(size_t length, uint32_t type) override { return {}; }
+    bool ok;
+    if (this->needs_compaction_ || this->log_size_ + changed_bytes > this->compaction_threshold_()) {
+      ok = this->compact_();
+    } else {
+      ok = this->append_dirty_();
+    }
+    if (!ok)
+      return false;
 
-  bool sync() override { return true; }
-  bool reset() override { return true; }
+    ESP_LOGD(TAG, "Synced %zu changed value(s), %zu bytes", this->dirty_.size(), changed_bytes);
+    this->dirty_.clear();
+    this->log_stats_();
+    return true;
+  }
+
+  bool reset() override {
+    this->values_.clear();
+    this->dirty_.clear();
+    this->needs_compaction_ = true;
+    return this->sync();
+  }
+
+  void open() {
+    if (this->path_.empty())
+      return;
+    FILE *fp = fopen(this->path_.c_str(), "rb");
+    if (fp == nullptr)
+      return;
+    HostPreferenceRecordHeader header;
+    while (fread(&header, sizeof(header), 1, fp) == 1) {
+      std::vector<uint8_t> data(header.length);
+      if ((!data.empty() && fread(data.data(), data.size(), 1, fp) != 1) ||
+          crc16(data.data(), data.size()) != header.crc) {
+        // Torn write at the end of the log, drop it with the next sync
+        ESP_LOGW(TAG, "Ignoring corrupt record at offset %zu of %s", this->log_size_, this->path_.c_str());
+        this->needs_compaction_ = true;
+        break;
+      }
+      this->log_size_ += sizeof(header) + data.size();
+      this->values_[header.type] = std::move(data);
+    }
+    fclose(fp);
+    ESP_LOGD(TAG, "Loaded %zu value(s) from %zu byte log %s", this->values_.size(), this->log_size_,
+             this->path_.c_str());
+  }
+
+  bool save(uint32_t type, const uint8_t *data, size_t len) {
+    if (len > UINT16_MAX)
+      return false;
+    this->save_count_++;
+    this->requested_bytes_ += len;
+    auto &value = this->values_[type];
+    if (value.size() == len && memcmp(value.data(), data, len) == 0)
+      return true;
+    value.assign(data, data + len);
+    this->dirty_.insert(type);
+    return true;
+  }
+
+  bool load(uint32_t type, uint8_t *data, size_t len) {
+    auto it = this->values_.find(type);
+    if (it == this->values_.end() || it->second.size() != len)
+      return false;
+    memcpy(data, it->second.data(), len);
+    return true;
+  }
+
+ protected:
+  size_t live_size_() const {
+    size_t size = 0;
+    for (auto &entry : this->values_)
+      size += sizeof(HostPreferenceRecordHeader) + entry.second.size();
+    return size;
+  }
+  size_t compaction_threshold_() const { return std::max(COMPACT_MIN_SIZE, COMPACT_RATIO * this->live_size_()); }
+
+  /// Write one record (only count it if there is no file), counting it in flash write units.
+  bool write_record_(FILE *fp, uint32_t type, const std::vector<uint8_t> &data) {
+    HostPreferenceRecordHeader header{type, (uint16_t) data.size(), crc16(data.data(), data.size())};
+    if (fp != nullptr) {
+      if (fwrite(&header, sizeof(header), 1, fp) != 1)
+        return false;
+      if (!data.empty() && fwrite(data.data(), data.size(), 1, fp) != 1)
+        return false;
+    }
+    size_t size = sizeof(header) + data.size();
+    this->flash_bytes_written_ += (size + FLASH_WRITE_UNIT - 1) / FLASH_WRITE_UNIT * FLASH_WRITE_UNIT;
+    this->log_size_ += size;
+    return true;
+  }
+
+  bool append_dirty_() {
+    FILE *fp = nullptr;
+    if (!this->path_.empty()) {
+      fp = fopen(this->path_.c_str(), "ab");
+      if (fp == nullptr) {
+        ESP_LOGW(TAG, "Could not open %s for writing, errno=%d", this->path_.c_str(), errno);
+        return false;
+      }
+    }
+    bool ok = true;
+    for (uint32_t type : this->dirty_)
+      ok = ok && this->write_record_(fp, type, this->values_[type]);
+    if (fp != nullptr)
+      ok &= fclose(fp) == 0;
+    if (!ok)
+      ESP_LOGW(TAG, "Appending to %s failed, errno=%d", this->path_.c_str(), errno);
+    return ok;
+  }
+
+  /// Rewrite the log with only the live values, like erasing a flash sector. The file is replaced atomically.
+  bool compact_() {
+    this->compaction_count_++;
+    this->log_size_ = 0;
+    FILE *fp = nullptr;
+    std::string tmp_path = this->path_ + ".tmp";
+    if (!this->path_.empty()) {
+      fp = fopen(tmp_path.c_str(), "wb");
+      if (fp == nullptr) {
+        ESP_LOGW(TAG, "Could not open %s for writing, errno=%d", tmp_path.c_str(), errno);
+        return false;
+      }
+    }
+    bool ok = true;
+    for (auto &entry : this->values_)
+      ok = ok && this->write_record_(fp, entry.first, entry.second);
+    if (fp != nullptr) {
+      ok &= fclose(fp) == 0;
+      ok = ok && rename(tmp_path.c_str(), this->path_.c_str()) == 0;
+    }
+    if (!ok) {
+      ESP_LOGW(TAG, "Writing preferences to %s failed, errno=%d", this->path_.c_str(), errno);
+      return false;
+    }
+    this->needs_compaction_ = false;
+    return true;
+  }
+
+  void log_stats_() {
+    const uint64_t uptime_ms = millis_64();
+    const float hours = uptime_ms / 3600000.0f;
+    const float amplification =
+        this->changed_bytes_ == 0 ? 0.0f : (float) this->flash_bytes_written_ / (float) this->changed_bytes_;
+    ESP_LOGD(TAG,
+             "Totals: %" PRIu32 " saves (%" PRIu64 " bytes), %" PRIu32 " syncs (%" PRIu64 " bytes changed), %" PRIu64
+             " bytes written to flash (x%.1f), %" PRIu32 " compactions",
+             this->save_count_, this->requested_bytes_, this->sync_count_, this->changed_bytes_,
+             this->flash_bytes_written_, amplification, this->compaction_count_);
+    if (hours > 0.0f)
+      ESP_LOGD(TAG, "Flash write rate: %.0f bytes/hour", this->flash_bytes_written_ / hours);
+  }
+
+  std::string path_;
+  std::map<uint32_t, std::vector<uint8_t>> values_;
+  /// Types changed since the last sync.
+  std::set<uint32_t> dirty_;
+  size_t log_size_{0};
+  bool needs_compaction_{false};
+
+  uint32_t save_count_{0};
+  uint64_t requested_bytes_{0};
+  uint32_t sync_count_{0};
+  uint64_t changed_bytes_{0};
+  uint64_t flash_bytes_written_{0};
+  uint32_t compaction_count_{0};
 };
 
+bool HostPreferenceBackend::save(const uint8_t *data, size_t len) {
+  return this->parent_->save(this->type_, data, len);
+}
+bool HostPreferenceBackend::load(uint8_t *data, size_t len) { return this->parent_->load(this->type_, data, len); }
+
 void setup_preferences() {
-  auto *pref = new HostPreferences();  // NOLINT(cppcoreguidelines-owning-memory)
+  auto *pref = new HostPreferences(get_options().preferences_path);  // NOLINT(cppcoreguidelines-owning-memory)
+  pref->open();
   global_preferences = pref;
 }
 
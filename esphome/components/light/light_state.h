@@ -167,6 +167,12 @@ class LightState : public EntityBase, public Component {
   /// Internal method to save the current remote_values to the preferences
   void save_remote_values_();
 
+  /// Internal method to write the light state in the next loop() cycle.
+  void schedule_write_() {
+    this->next_write_ = true;
+    this->enable_loop();
+  }
+
   /// Store the output to allow effects to have more access.
   LightOutput *output_;
   /// Value for storing the index of the currently active effect. 0 if no effect is active
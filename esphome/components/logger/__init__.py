@@ -136,6 +136,7 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_TASK_LOG_BUFFER_SIZE = "task_log_buffer_size"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -167,6 +168,9 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.Optional(CONF_TASK_LOG_BUFFER_SIZE): cv.All(
+                cv.only_on_esp32, cv.int_range(min=1, max=256)
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
@@ -183,6 +187,9 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
+    if CONF_TASK_LOG_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_RING_BUFFER")
+        cg.add(log.set_task_log_buffer_size(config[CONF_TASK_LOG_BUFFER_SIZE]))
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
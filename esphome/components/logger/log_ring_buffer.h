@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace logger {
+
+/** Log messages of other tasks, waiting for the main loop to write them out.
+ *
+ * A bounded multi-producer, single-consumer queue of fixed size slots, after Dmitry Vyukov's bounded queue. A producer
+ * claims a slot with a compare-and-swap on the write position, formats its message right into the slot and publishes
+ * it through the sequence number of the slot, without taking a lock or allocating memory. Only the main loop takes
+ * messages out. When every slot is in use, new messages are dropped and counted.
+ */
+class LogRingBuffer {
+ public:
+  struct Slot {
+    /// Equal to the position of the slot while it can be claimed, one more once its message can be read.
+    std::atomic<uint32_t> sequence;
+    int level;
+    const char *tag;
+    /// Null terminated message, up to message_size characters.
+    char *text;
+  };
+
+  /// The number of slots is rounded up to a power of two.
+  LogRingBuffer(size_t slots, size_t message_size) : message_size_(message_size) {
+    size_t capacity = 1;
+    while (capacity < slots)
+      capacity <<= 1;
+    this->mask_ = capacity - 1;
+    this->slots_ = std::unique_ptr<Slot[]>{new Slot[capacity]};
+    this->text_ = std::unique_ptr<char[]>{new char[capacity * (message_size + 1)]};
+    for (size_t i = 0; i < capacity; i++) {
+      this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+      this->slots_[i].text = &this->text_[i * (message_size + 1)];
+    }
+  }
+
+  size_t capacity() const { return this->mask_ + 1; }
+  size_t message_size() const { return this->message_size_; }
+
+  /// Claim a slot to write a message to and hand to commit(), nullptr if they are all in use. Safe from any task.
+  Slot *claim() {
+    uint32_t position = this->write_position_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = this->slots_[position & this->mask_];
+      const int32_t diff = int32_t(slot.sequence.load(std::memory_order_acquire) - position);
+      if (diff == 0) {
+        // On failure position is updated to the current write position
+        if (this->write_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          return &slot;
+      } else if (diff < 0) {
+        // The slot still holds a message from the previous round, the buffer is full
+        this->dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      } else {
+        position = this->write_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  /// Make the message in a claimed slot available to the main loop.
+  void commit(Slot *slot) {
+    slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /// The oldest message, nullptr if there is none ready yet. Only the main loop may call this and release().
+  Slot *peek() {
+    Slot &slot = this->slots_[this->read_position_ & this->mask_];
+    if (int32_t(slot.sequence.load(std::memory_order_acquire) - (this->read_position_ + 1)) < 0)
+      return nullptr;
+    return &slot;
+  }
+  /// Free the slot returned by peek() once its message was written.
+  void release(Slot *slot) {
+    slot->sequence.store(this->read_position_ + this->mask_ + 1, std::memory_order_release);
+    this->read_position_++;
+  }
+
+  /// Number of messages dropped since the last call.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
+
+ protected:
+  std::unique_ptr<Slot[]> slots_;
+  std::unique_ptr<char[]> text_;
+  size_t message_size_;
+  uint32_t mask_;
+  std::atomic<uint32_t> write_position_{0};
+  uint32_t read_position_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
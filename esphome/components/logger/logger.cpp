@@ -1,4 +1,5 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
 
 #ifdef USE_ESP_IDF
@@ -50,7 +51,15 @@ void Logger::write_header_(int level, const char *tag, int line) {
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+#ifdef USE_LOGGER_RING_BUFFER
+  if (this->ring_buffer_ != nullptr && !this->is_main_task_()) {
+    this->queue_message_(level, tag, line, format, args);
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -111,7 +120,9 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // make sure null terminator is present
   this->set_null_terminator_();
 
-  const char *msg = this->tx_buffer_ + offset;
+  this->write_message_(level, tag, this->tx_buffer_ + offset);
+}
+void HOT Logger::write_message_(int level, const char *tag, const char *msg) {
   if (this->baud_rate_ > 0) {
 #ifdef USE_ARDUINO
     this->hw_serial_->println(msg);
@@ -152,6 +163,57 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->log_callback_.call(level, tag, msg);
 }
 
+#ifdef USE_LOGGER_RING_BUFFER
+void Logger::set_task_log_buffer_size(size_t messages) {
+  this->ring_buffer_ = make_unique<LogRingBuffer>(messages, this->tx_buffer_size_);
+}
+
+void HOT Logger::queue_message_(int level, const char *tag, int line, const char *format, va_list args) {
+  LogRingBuffer::Slot *slot = this->ring_buffer_->claim();
+  if (slot == nullptr)
+    return;
+
+  // Same as the header, message and footer log_vprintf_() writes to tx_buffer_
+  char *text = slot->text;
+  const int size = this->ring_buffer_->message_size();
+  const int clamped = std::max(0, std::min(level, 7));
+  int length = snprintf(text, size + 1, "%s[%s][%s:%03u]: ", LOG_LEVEL_COLORS[clamped], LOG_LEVEL_LETTERS[clamped],
+                        tag, line);
+  length = std::max(0, std::min(length, size));
+  int ret = vsnprintf(text + length, size + 1 - length, format, args);
+  if (ret > 0)
+    length = std::min(length + ret, size);
+  length += snprintf(text + length, size + 1 - length, "%s", ESPHOME_LOG_RESET_COLOR);
+  length = std::min(length, size);
+  // remove trailing newline
+  if (length > 0 && text[length - 1] == '\n')
+    length--;
+  text[length] = '\0';
+
+  slot->level = level;
+  slot->tag = tag;
+  this->ring_buffer_->commit(slot);
+}
+
+void Logger::loop() {
+  if (this->ring_buffer_ == nullptr)
+    return;
+  // Only write the messages queued so far, the ones other tasks keep adding meanwhile wait for the next loop
+  for (size_t i = 0; i < this->ring_buffer_->capacity(); i++) {
+    LogRingBuffer::Slot *slot = this->ring_buffer_->peek();
+    if (slot == nullptr)
+      break;
+    this->recursion_guard_ = true;
+    this->write_message_(slot->level, slot->tag, slot->text);
+    this->recursion_guard_ = false;
+    this->ring_buffer_->release(slot);
+  }
+  const uint32_t dropped = this->ring_buffer_->take_dropped();
+  if (dropped > 0)
+    ESP_LOGW(TAG, "%" PRIu32 " log messages of other tasks were dropped, the task log buffer was full", dropped);
+}
+#endif  // USE_LOGGER_RING_BUFFER
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
   // add 1 to buffer size for null terminator
   this->tx_buffer_ = new char[this->tx_buffer_size_ + 1];  // NOLINT
@@ -252,6 +314,9 @@ void Logger::pre_setup() {
   }
 #endif  // USE_ESP8266
 
+#ifdef USE_LOGGER_RING_BUFFER
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#endif
   global_logger = this;
 #if defined(USE_ESP_IDF) || defined(USE_ESP32_FRAMEWORK_ARDUINO)
   esp_log_set_vprintf(esp_idf_log_vprintf_);
@@ -306,6 +371,10 @@ void Logger::dump_config() {
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040)
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
 #endif
+#ifdef USE_LOGGER_RING_BUFFER
+  if (this->ring_buffer_ != nullptr)
+    ESP_LOGCONFIG(TAG, "  Task Log Buffer: %u messages", (unsigned) this->ring_buffer_->capacity());
+#endif
 
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
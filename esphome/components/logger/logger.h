@@ -21,6 +21,13 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#ifdef USE_LOGGER_RING_BUFFER
+#include <memory>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "log_ring_buffer.h"
+#endif  // USE_LOGGER_RING_BUFFER
+
 namespace esphome {
 
 namespace logger {
@@ -78,6 +85,15 @@ class Logger : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_RING_BUFFER
+  /** Queue the messages logged by other tasks than the main loop, and write them out from the main loop.
+   *
+   * Other tasks then only format their messages, and never wait for the UART or call the log callbacks.
+   */
+  void set_task_log_buffer_size(size_t messages);
+  void loop() override;
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -100,6 +116,12 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  /// Write a message to the UART and pass it to the log callbacks.
+  void write_message_(int level, const char *tag, const char *msg);
+#ifdef USE_LOGGER_RING_BUFFER
+  void queue_message_(int level, const char *tag, int line, const char *format, va_list args);
+  bool is_main_task_() const { return !xPortInIsrContext() && xTaskGetCurrentTaskHandle() == this->main_task_; }
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -158,6 +180,10 @@ class Logger : public Component {
   };
   std::vector<LogLevelOverride> log_levels_;
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
+#ifdef USE_LOGGER_RING_BUFFER
+  std::unique_ptr<LogRingBuffer> ring_buffer_;
+  TaskHandle_t main_task_{nullptr};
+#endif
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
 };
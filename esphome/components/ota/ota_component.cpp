@@ -85,6 +85,10 @@ void OTAComponent::setup() {
     this->mark_failed();
     return;
   }
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  // loop() accepts from the server socket, the client socket is then read in the same call
+  App.register_socket_fd(server_->get_fd());
+#endif
 
   this->dump_config();
 }
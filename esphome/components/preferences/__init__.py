@@ -1,24 +1,41 @@
 from esphome.const import CONF_ID
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 
 CODEOWNERS = ["@esphome/core"]
 
 preferences_ns = cg.esphome_ns.namespace("preferences")
 IntervalSyncer = preferences_ns.class_("IntervalSyncer", cg.Component)
 
+CONF_PREFERENCES_ID = "preferences_id"
 CONF_FLASH_WRITE_INTERVAL = "flash_write_interval"
+CONF_COALESCE_WRITES = "coalesce_writes"
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(IntervalSyncer),
         cv.Optional(
             CONF_FLASH_WRITE_INTERVAL, default="60s"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_COALESCE_WRITES, default=False): cv.boolean,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
 
+def validate_coalescing(config):
+    """Final validation for the diagnostic platforms, which report on the coalescing layer."""
+    preferences = fv.full_config.get().get("preferences", {})
+    if not preferences.get(CONF_COALESCE_WRITES, False):
+        raise cv.Invalid(
+            f"The preferences sensors require '{CONF_COALESCE_WRITES}: true' in the preferences component"
+        )
+    return config
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_write_interval(config[CONF_FLASH_WRITE_INTERVAL]))
+    if config[CONF_COALESCE_WRITES]:
+        cg.add_define("USE_PREFERENCES_COALESCING")
+        cg.add(var.enable_coalescing())
     await cg.register_component(var, config)
@@ -0,0 +1,133 @@
+#include "coalescing.h"
+
+#ifdef USE_PREFERENCES_COALESCING
+
+#include <cinttypes>
+#include <cstring>
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace preferences {
+
+static const char *const TAG = "preferences.coalescing";
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (len--) {
+    crc ^= *data++;
+    for (uint8_t i = 0; i < 8; i++)
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+bool CoalescingPreferenceBackend::save(const uint8_t *data, size_t len) {
+  uint32_t crc = crc32(data, len);
+  if (this->crc_valid_ && crc == this->crc_) {
+    // Same as the pending value, or as the value in flash if nothing is pending
+    this->skip_count_++;
+    this->parent_->skip_count_++;
+    return true;
+  }
+  this->pending_.assign(data, data + len);
+  this->crc_ = crc;
+  this->crc_valid_ = true;
+  if (!this->dirty_) {
+    this->dirty_ = true;
+    this->parent_->dirty_.push_back(this);
+  }
+  return true;
+}
+
+bool CoalescingPreferenceBackend::load(uint8_t *data, size_t len) {
+  if (this->dirty_) {
+    if (this->pending_.size() != len)
+      return false;
+    memcpy(data, this->pending_.data(), len);
+    return true;
+  }
+  if (!this->inner_->load(data, len))
+    return false;
+  this->crc_ = crc32(data, len);
+  this->crc_valid_ = true;
+  return true;
+}
+
+bool CoalescingPreferenceBackend::flush_() {
+  if (!this->inner_->save(this->pending_.data(), this->pending_.size()))
+    return false;
+  this->write_count_++;
+  this->parent_->write_count_++;
+  this->parent_->bytes_written_ += this->pending_.size();
+  this->dirty_ = false;
+  this->pending_.clear();
+  this->pending_.shrink_to_fit();
+  return true;
+}
+
+ESPPreferenceObject CoalescingPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
+  return this->wrap_(this->inner_->make_preference(length, type, in_flash), type, in_flash);
+}
+
+ESPPreferenceObject CoalescingPreferences::make_preference(size_t length, uint32_t type) {
+#if defined(USE_ESP8266) && !defined(USE_ESP8266_PREFERENCES_FLASH)
+  // The ESP8266 preferences keep these in RTC memory
+  const bool in_flash = false;
+#else
+  const bool in_flash = true;
+#endif
+  return this->wrap_(this->inner_->make_preference(length, type), type, in_flash);
+}
+
+ESPPreferenceObject CoalescingPreferences::wrap_(ESPPreferenceObject inner, uint32_t type, bool in_flash) {
+  // No room left for the value in the platform preferences
+  if (inner.get_backend() == nullptr)
+    return inner;
+#ifdef USE_ESP8266
+  // RTC memory doesn't wear out, the other platforms store everything in flash
+  if (!in_flash)
+    return inner;
+#endif
+  auto *backend =
+      new CoalescingPreferenceBackend(this, inner.get_backend(), type);  // NOLINT(cppcoreguidelines-owning-memory)
+  this->objects_.push_back(backend);
+  return {backend};
+}
+
+bool CoalescingPreferences::sync() {
+  if (!this->dirty_.empty()) {
+    size_t count = this->dirty_.size();
+    bool ok = true;
+    std::vector<CoalescingPreferenceBackend *> failed;
+    for (auto *backend : this->dirty_) {
+      if (!backend->flush_()) {
+        ok = false;
+        failed.push_back(backend);
+      }
+    }
+    this->dirty_.swap(failed);
+    if (!ok)
+      ESP_LOGW(TAG, "Writing %zu of %zu value(s) failed", this->dirty_.size(), count);
+    ESP_LOGV(TAG, "Flushed %zu value(s), %" PRIu32 " writes and %" PRIu32 " skipped in total", count,
+             this->write_count_, this->skip_count_);
+    if (!ok)
+      return false;
+  }
+  return this->inner_->sync();
+}
+
+bool CoalescingPreferences::reset() {
+  for (auto *backend : this->dirty_) {
+    backend->dirty_ = false;
+    backend->pending_.clear();
+  }
+  this->dirty_.clear();
+  for (auto *backend : this->objects_)
+    backend->crc_valid_ = false;
+  return this->inner_->reset();
+}
+
+}  // namespace preferences
+}  // namespace esphome
+
+#endif  // USE_PREFERENCES_COALESCING
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_PREFERENCES_COALESCING
+
+#include <vector>
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace preferences {
+
+class CoalescingPreferences;
+
+/// A preference object going through CoalescingPreferences, holds the value until the next flush.
+class CoalescingPreferenceBackend : public ESPPreferenceBackend {
+ public:
+  CoalescingPreferenceBackend(CoalescingPreferences *parent, ESPPreferenceBackend *inner, uint32_t type)
+      : parent_(parent), inner_(inner), type_(type) {}
+
+  bool save(const uint8_t *data, size_t len) override;
+  bool load(uint8_t *data, size_t len) override;
+
+  uint32_t get_type() const { return this->type_; }
+  /// Number of times the value was written to the underlying preferences.
+  uint32_t get_write_count() const { return this->write_count_; }
+  /// Number of save() calls that did not change the value.
+  uint32_t get_skip_count() const { return this->skip_count_; }
+
+ protected:
+  friend CoalescingPreferences;
+
+  bool flush_();
+
+  CoalescingPreferences *parent_;
+  ESPPreferenceBackend *inner_;
+  uint32_t type_;
+  /// CRC of the latest value, saved or loaded.
+  uint32_t crc_{0};
+  bool crc_valid_{false};
+  bool dirty_{false};
+  std::vector<uint8_t> pending_;
+  uint32_t write_count_{0};
+  uint32_t skip_count_{0};
+};
+
+/** Preferences layer that coalesces writes before they reach the platform preferences.
+ *
+ * save() calls with the same value as the last saved or loaded one (by CRC) are dropped. Other values are only held in
+ * memory until the next sync(), which writes every changed object once, no matter how often it was saved since. The
+ * flush window is therefore the `flash_write_interval` of the preferences component.
+ */
+class CoalescingPreferences : public ESPPreferences {
+ public:
+  explicit CoalescingPreferences(ESPPreferences *inner) : inner_(inner) {}
+
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override;
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override;
+  bool sync() override;
+  bool reset() override;
+
+  /// Number of values written to the underlying preferences.
+  uint32_t get_write_count() const { return this->write_count_; }
+  /// Number of save() calls dropped because the value didn't change.
+  uint32_t get_skip_count() const { return this->skip_count_; }
+  /// Number of bytes written to the underlying preferences.
+  uint32_t get_bytes_written() const { return this->bytes_written_; }
+  const std::vector<CoalescingPreferenceBackend *> &get_objects() const { return this->objects_; }
+
+ protected:
+  friend CoalescingPreferenceBackend;
+
+  /// Coalesce the writes of a platform preference object, unless it isn't stored in flash.
+  ESPPreferenceObject wrap_(ESPPreferenceObject inner, uint32_t type, bool in_flash);
+
+  ESPPreferences *inner_;
+  std::vector<CoalescingPreferenceBackend *> objects_;
+  std::vector<CoalescingPreferenceBackend *> dirty_;
+  uint32_t write_count_{0};
+  uint32_t skip_count_{0};
+  uint32_t bytes_written_{0};
+};
+
+}  // namespace preferences
+}  // namespace esphome
+
+#endif  // USE_PREFERENCES_COALESCING
@@ -0,0 +1,58 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_BYTES,
+)
+from . import CONF_PREFERENCES_ID, IntervalSyncer, validate_coalescing
+
+DEPENDENCIES = ["preferences"]
+
+CONF_WRITES = "writes"
+CONF_SKIPPED_WRITES = "skipped_writes"
+CONF_BYTES_WRITTEN = "bytes_written"
+
+CONFIG_SCHEMA = {
+    cv.GenerateID(CONF_PREFERENCES_ID): cv.use_id(IntervalSyncer),
+    cv.Optional(CONF_WRITES): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_SKIPPED_WRITES): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_BYTES_WRITTEN): sensor.sensor_schema(
+        unit_of_measurement=UNIT_BYTES,
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+}
+
+
+FINAL_VALIDATE_SCHEMA = validate_coalescing
+
+
+async def to_code(config):
+    syncer = await cg.get_variable(config[CONF_PREFERENCES_ID])
+
+    if CONF_WRITES in config:
+        sens = await sensor.new_sensor(config[CONF_WRITES])
+        cg.add(syncer.set_writes_sensor(sens))
+
+    if CONF_SKIPPED_WRITES in config:
+        sens = await sensor.new_sensor(config[CONF_SKIPPED_WRITES])
+        cg.add(syncer.set_skipped_writes_sensor(sens))
+
+    if CONF_BYTES_WRITTEN in config:
+        sens = await sensor.new_sensor(config[CONF_BYTES_WRITTEN])
+        cg.add(syncer.set_bytes_written_sensor(sens))
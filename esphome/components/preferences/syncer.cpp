@@ -0,0 +1,63 @@
+#include "syncer.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace preferences {
+
+/// Number of preferences listed by the top writers text sensor.
+static const size_t TOP_WRITERS_COUNT = 3;
+
+void IntervalSyncer::sync_() {
+  global_preferences->sync();
+#ifdef USE_PREFERENCES_COALESCING
+  this->publish_stats_();
+#endif
+}
+
+#ifdef USE_PREFERENCES_COALESCING
+void IntervalSyncer::enable_coalescing() {
+  if (this->coalescing_ != nullptr)
+    return;
+  this->coalescing_ = new CoalescingPreferences(global_preferences);  // NOLINT(cppcoreguidelines-owning-memory)
+  global_preferences = this->coalescing_;
+}
+
+void IntervalSyncer::publish_stats_() {
+  if (this->coalescing_ == nullptr)
+    return;
+#ifdef USE_SENSOR
+  if (this->writes_sensor_ != nullptr)
+    this->writes_sensor_->publish_state(this->coalescing_->get_write_count());
+  if (this->skipped_writes_sensor_ != nullptr)
+    this->skipped_writes_sensor_->publish_state(this->coalescing_->get_skip_count());
+  if (this->bytes_written_sensor_ != nullptr)
+    this->bytes_written_sensor_->publish_state(this->coalescing_->get_bytes_written());
+#endif
+#ifdef USE_TEXT_SENSOR
+  if (this->top_writers_sensor_ != nullptr) {
+    std::vector<CoalescingPreferenceBackend *> objects = this->coalescing_->get_objects();
+    size_t count = std::min(TOP_WRITERS_COUNT, objects.size());
+    std::partial_sort(objects.begin(), objects.begin() + count, objects.end(),
+                      [](CoalescingPreferenceBackend *a, CoalescingPreferenceBackend *b) {
+                        return a->get_write_count() > b->get_write_count();
+                      });
+    std::string state;
+    for (size_t i = 0; i < count && objects[i]->get_write_count() > 0; i++) {
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%s%08" PRIX32 ": %" PRIu32, state.empty() ? "" : ", ", objects[i]->get_type(),
+               objects[i]->get_write_count());
+      state += buf;
+    }
+    this->top_writers_sensor_->publish_state(state);
+  }
+#endif
+}
+#endif
+
+}  // namespace preferences
+}  // namespace esphome
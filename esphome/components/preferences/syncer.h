@@ -1,8 +1,19 @@
 #pragma once
 
+#include "esphome/core/defines.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/component.h"
 
+#ifdef USE_PREFERENCES_COALESCING
+#include "coalescing.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
+#endif
+
 namespace esphome {
 namespace preferences {
 
@@ -10,13 +21,43 @@ class IntervalSyncer : public Component {
  public:
   void set_write_interval(uint32_t write_interval) { write_interval_ = write_interval; }
   void setup() override {
-    set_interval(write_interval_, []() { global_preferences->sync(); });
+    set_interval(write_interval_, [this]() { this->sync_(); });
   }
-  void on_shutdown() override { global_preferences->sync(); }
+  void on_shutdown() override { this->sync_(); }
   float get_setup_priority() const override { return setup_priority::BUS; }
 
+#ifdef USE_PREFERENCES_COALESCING
+  /// Route all preferences created from now on through a CoalescingPreferences layer.
+  void enable_coalescing();
+#ifdef USE_SENSOR
+  void set_writes_sensor(sensor::Sensor *writes_sensor) { writes_sensor_ = writes_sensor; }
+  void set_skipped_writes_sensor(sensor::Sensor *skipped_writes_sensor) {
+    skipped_writes_sensor_ = skipped_writes_sensor;
+  }
+  void set_bytes_written_sensor(sensor::Sensor *bytes_written_sensor) { bytes_written_sensor_ = bytes_written_sensor; }
+#endif
+#ifdef USE_TEXT_SENSOR
+  void set_top_writers_sensor(text_sensor::TextSensor *top_writers_sensor) { top_writers_sensor_ = top_writers_sensor; }
+#endif
+#endif
+
  protected:
+  void sync_();
+
   uint32_t write_interval_;
+#ifdef USE_PREFERENCES_COALESCING
+  void publish_stats_();
+
+  CoalescingPreferences *coalescing_{nullptr};
+#ifdef USE_SENSOR
+  sensor::Sensor *writes_sensor_{nullptr};
+  sensor::Sensor *skipped_writes_sensor_{nullptr};
+  sensor::Sensor *bytes_written_sensor_{nullptr};
+#endif
+#ifdef USE_TEXT_SENSOR
+  text_sensor::TextSensor *top_writers_sensor_{nullptr};
+#endif
+#endif
 };
 
 }  // namespace preferences
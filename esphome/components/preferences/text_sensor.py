@@ -0,0 +1,32 @@
+from esphome.components import text_sensor
+import esphome.config_validation as cv
+import esphome.codegen as cg
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+)
+
+from . import CONF_PREFERENCES_ID, IntervalSyncer, validate_coalescing
+
+DEPENDENCIES = ["preferences"]
+
+CONF_TOP_WRITERS = "top_writers"
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_PREFERENCES_ID): cv.use_id(IntervalSyncer),
+        cv.Optional(CONF_TOP_WRITERS): text_sensor.text_sensor_schema(
+            icon=ICON_COUNTER,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+FINAL_VALIDATE_SCHEMA = validate_coalescing
+
+
+async def to_code(config):
+    syncer = await cg.get_variable(config[CONF_PREFERENCES_ID])
+
+    if CONF_TOP_WRITERS in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_TOP_WRITERS])
+        cg.add(syncer.set_top_writers_sensor(sens))
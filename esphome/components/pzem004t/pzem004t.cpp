@@ -98,6 +98,8 @@ void PZEM004T::update() { this->write_state_(READ_VOLTAGE); }
 void PZEM004T::write_state_(PZEM004T::PZEM004TReadState state) {
   if (state == DONE) {
     this->read_state_ = state;
+    // All readings received, loop() has nothing to parse until the next update() sends a request
+    this->disable_loop();
     return;
   }
   std::array<uint8_t, 7> data{};
@@ -113,6 +115,9 @@ void PZEM004T::write_state_(PZEM004T::PZEM004TReadState state) {
 
   this->write_array(data);
   this->read_state_ = state;
+  // Give the response the full 500ms before loop() discards incomplete data, loop() may not have run for a while
+  this->last_read_ = millis();
+  this->enable_loop();
 }
 void PZEM004T::dump_config() {
   ESP_LOGCONFIG(TAG, "PZEM004T:");
@@ -28,6 +28,8 @@ static const uint16_t SCD40_ID = 0x440;
 
 void SCD4XComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up scd4x...");
+  // Don't hold back other components while waiting for the sensor, mark_failed() also ends the async setup
+  this->begin_async_setup_();
   // the sensor needs 1000 ms to enter the idle state
   this->set_timeout(1000, [this]() {
     this->status_clear_error();
@@ -86,6 +88,7 @@ void SCD4XComponent::setup() {
       // Finally start sensor measurements
       this->start_measurement_();
       ESP_LOGD(TAG, "Sensor initialized");
+      this->complete_async_setup_();
     });
   });
 }
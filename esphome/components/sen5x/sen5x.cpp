@@ -26,6 +26,8 @@ static const uint16_t SEN5X_CMD_VOC_ALGORITHM_TUNING = 0x60D0;
 
 void SEN5XComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up sen5x...");
+  // Don't hold back other components while waiting for the sensor, mark_failed() also ends the async setup
+  this->begin_async_setup_();
 
   // the sensor needs 1000 ms to enter the idle state
   this->set_timeout(1000, [this]() {
@@ -220,6 +222,7 @@ void SEN5XComponent::setup() {
       }
       initialized_ = true;
       ESP_LOGD(TAG, "Sensor initialized");
+      this->complete_async_setup_();
     });
   });
 }
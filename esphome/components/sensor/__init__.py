@@ -26,6 +26,7 @@ from esphome.const import (
     CONF_TIMEOUT,
     CONF_TO,
     CONF_TRIGGER_ID,
+    CONF_TYPE_ID,
     CONF_TYPE,
     CONF_UNIT_OF_MEASUREMENT,
     CONF_WINDOW_SIZE,
@@ -87,7 +88,7 @@ from esphome.const import (
     DEVICE_CLASS_WIND_SPEED,
 )
 from esphome.core import CORE, coroutine_with_priority
-from esphome.cpp_generator import MockObjClass
+from esphome.cpp_generator import FloatLiteral, MockObjClass
 from esphome.cpp_helpers import setup_entity
 from esphome.util import Registry
 
@@ -218,6 +219,8 @@ ExponentialMovingAverageFilter = sensor_ns.class_(
     "ExponentialMovingAverageFilter", Filter
 )
 ThrottleAverageFilter = sensor_ns.class_("ThrottleAverageFilter", Filter, cg.Component)
+TimeWindowFilter = sensor_ns.class_("TimeWindowFilter", Filter, cg.Component)
+TimeWindowType = sensor_ns.enum("TimeWindowType")
 LambdaFilter = sensor_ns.class_("LambdaFilter", Filter)
 OffsetFilter = sensor_ns.class_("OffsetFilter", Filter)
 MultiplyFilter = sensor_ns.class_("MultiplyFilter", Filter)
@@ -480,6 +483,63 @@ async def throttle_average_filter_to_code(config, filter_id):
     return var
 
 
+CONF_WINDOW = "window"
+TIME_WINDOW_TYPES = {
+    "min": TimeWindowType.TIME_WINDOW_MIN,
+    "max": TimeWindowType.TIME_WINDOW_MAX,
+    "mean": TimeWindowType.TIME_WINDOW_MEAN,
+    "stddev": TimeWindowType.TIME_WINDOW_STDDEV,
+    "quantile": TimeWindowType.TIME_WINDOW_QUANTILE,
+}
+# The window is made of buckets as long as send_every, each one keeps a summary of its values
+MAX_TIME_WINDOW_BUCKETS = 30
+validate_time_window_period = cv.All(
+    cv.positive_time_period_milliseconds,
+    cv.Range(min=cv.TimePeriod(milliseconds=1)),
+)
+
+
+def validate_time_window(config):
+    config.setdefault(CONF_SEND_EVERY, config[CONF_WINDOW])
+    window = config[CONF_WINDOW].total_milliseconds
+    send_every = config[CONF_SEND_EVERY].total_milliseconds
+    if window % send_every != 0:
+        raise cv.Invalid(
+            f"window must be a multiple of send_every! {window}ms % {send_every}ms != 0"
+        )
+    if window // send_every > MAX_TIME_WINDOW_BUCKETS:
+        raise cv.Invalid(
+            f"window can be at most {MAX_TIME_WINDOW_BUCKETS} times send_every"
+        )
+    return config
+
+
+TIME_WINDOW_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_TYPE): cv.enum(TIME_WINDOW_TYPES, lower=True),
+            cv.Required(CONF_WINDOW): validate_time_window_period,
+            cv.Optional(CONF_SEND_EVERY): validate_time_window_period,
+            cv.Optional(CONF_QUANTILE, default=0.5): cv.zero_to_one_float,
+        }
+    ),
+    validate_time_window,
+)
+
+
+@FILTER_REGISTRY.register("time_window", TimeWindowFilter, TIME_WINDOW_SCHEMA)
+async def time_window_filter_to_code(config, filter_id):
+    var = cg.new_Pvariable(
+        filter_id,
+        config[CONF_WINDOW],
+        config[CONF_SEND_EVERY],
+        config[CONF_TYPE],
+        config[CONF_QUANTILE],
+    )
+    await cg.register_component(var, {})
+    return var
+
+
 @FILTER_REGISTRY.register("lambda", LambdaFilter, cv.returning_lambda)
 async def lambda_filter_to_code(config, filter_id):
     lambda_ = await cg.process_lambda(
@@ -611,16 +671,17 @@ def validate_calibrate_linear(config):
     ),
 )
 async def calibrate_linear_filter_to_code(config, filter_id):
+    return cg.new_Pvariable(filter_id, calibrate_linear_functions(config))
+
+
+def calibrate_linear_functions(config):
     x = [conf[CONF_FROM] for conf in config[CONF_DATAPOINTS]]
     y = [conf[CONF_TO] for conf in config[CONF_DATAPOINTS]]
 
-    linear_functions = []
     if config[CONF_METHOD] == "least_squares":
         k, b = fit_linear(x, y)
-        linear_functions = [[k, b, float("NaN")]]
-    elif config[CONF_METHOD] == "exact":
-        linear_functions = map_linear(x, y)
-    return cg.new_Pvariable(filter_id, linear_functions)
+        return [[k, b, float("NaN")]]
+    return map_linear(x, y)
 
 
 CONF_DEGREE = "degree"
@@ -691,8 +752,88 @@ async def clamp_filter_to_code(config, filter_id):
     )
 
 
+def _float_code(value):
+    if math.isinf(value):
+        return "INFINITY" if value > 0 else "-INFINITY"
+    return str(FloatLiteral(float(value)))
+
+
+async def _fused_step_code(name, config):
+    """C++ statements applying a stateless filter to x, returning false to drop it."""
+    if name == "offset":
+        return f"x += {_float_code(config)};"
+    if name == "multiply":
+        return f"x *= {_float_code(config)};"
+    if name == "calibrate_linear":
+        # Like CalibrateLinearFilter: the first function bounded above x, or unbounded
+        code = []
+        for slope, bias, upper in calibrate_linear_functions(config):
+            apply = f"x = (x * {_float_code(slope)}) + {_float_code(bias)};"
+            if not math.isfinite(upper):
+                code.append(f"else {{ {apply} }}" if code else apply)
+                return "\n".join(code)
+            prefix = "else " if code else ""
+            code.append(f"{prefix}if (x < {_float_code(upper)}) {{ {apply} }}")
+        code.append("else { x = NAN; }")
+        return "\n".join(code)
+    if name == "clamp":
+        # Same as ClampFilter, limits that aren't finite don't clamp
+        min_value = config[CONF_MIN_VALUE]
+        max_value = config[CONF_MAX_VALUE]
+        min_code = _float_code(min_value if math.isfinite(min_value) else -math.inf)
+        max_code = _float_code(max_value if math.isfinite(max_value) else math.inf)
+        return (
+            f"if (std::isfinite(x)) {{ x = x < {min_code} ? {min_code} : "
+            f"(x > {max_code} ? {max_code} : x); }}"
+        )
+    if name == "lambda":
+        lambda_ = await cg.process_lambda(
+            config, [(float, "x")], return_type=cg.optional.template(float)
+        )
+        return (
+            f"{{ auto result = ({lambda_})(x);\n"
+            "if (!result.has_value()) { return false; }\n"
+            "x = *result; }"
+        )
+    raise ValueError(f"Filter {name} can't be fused")
+
+
+# Filters without state, consecutive ones are fused into a single filter object
+FUSABLE_FILTERS = {"offset", "multiply", "calibrate_linear", "clamp", "lambda"}
+
+
+async def build_fused_filter(configs):
+    """Build consecutive stateless filters as a single FusedFilter."""
+    steps = []
+    for full_config in configs:
+        entry, config = cg.extract_registry_entry_config(FILTER_REGISTRY, full_config)
+        steps.append(await _fused_step_code(entry.name, config))
+    body = "\n".join(steps)
+    fused = cg.RawExpression(f"[=](float &x) -> bool {{\n{body}\nreturn true;\n}}")
+    return cg.Pvariable(
+        configs[0][CONF_TYPE_ID], sensor_ns.make_fused_filter(fused), Filter
+    )
+
+
 async def build_filters(config):
-    return await cg.build_registry_list(FILTER_REGISTRY, config)
+    filters = []
+    fusable = []
+    for full_config in config + [None]:
+        if full_config is not None:
+            entry, _ = cg.extract_registry_entry_config(FILTER_REGISTRY, full_config)
+            if entry.name in FUSABLE_FILTERS:
+                fusable.append(full_config)
+                continue
+        # A single stateless filter gains nothing from being fused
+        if len(fusable) > 1:
+            filters.append(await build_fused_filter(fusable))
+        else:
+            for conf in fusable:
+                filters.append(await cg.build_registry_entry(FILTER_REGISTRY, conf))
+        fusable = []
+        if full_config is not None:
+            filters.append(await cg.build_registry_entry(FILTER_REGISTRY, full_config))
+    return filters
 
 
 async def setup_sensor_core_(var, config):
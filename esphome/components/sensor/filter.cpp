@@ -9,6 +9,13 @@ namespace sensor {
 
 static const char *const TAG = "sensor.filter";
 
+// Scheduler ids of the time based filters, these are rescheduled on (almost) every value.
+static const uint32_t THROTTLE_AVERAGE_ID = fnv1_hash_static("throttle_average");
+static const uint32_t TIME_WINDOW_ID = fnv1_hash_static("time_window");
+static const uint32_t TIMEOUT_ID = fnv1_hash_static("timeout");
+static const uint32_t DEBOUNCE_ID = fnv1_hash_static("debounce");
+static const uint32_t HEARTBEAT_ID = fnv1_hash_static("heartbeat");
+
 // Filter
 void Filter::input(float value) {
   ESP_LOGVV(TAG, "Filter(%p)::input(%f)", this, value);
@@ -16,6 +23,22 @@ void Filter::input(float value) {
   if (out.has_value())
     this->output(*out);
 }
+size_t Filter::new_values(float *values, size_t count) {
+  size_t out = 0;
+  for (size_t i = 0; i < count; i++) {
+    optional<float> value = this->new_value(values[i]);
+    if (value.has_value())
+      values[out++] = *value;
+  }
+  return out;
+}
+size_t Filter::input_block(float *values, size_t count) {
+  ESP_LOGVV(TAG, "Filter(%p)::input_block(%zu values)", this, count);
+  count = this->new_values(values, count);
+  if (this->next_ == nullptr || count == 0)
+    return count;
+  return this->next_->input_block(values, count);
+}
 void Filter::output(float value) {
   if (this->next_ == nullptr) {
     ESP_LOGVV(TAG, "Filter(%p)::output(%f) -> SENSOR", this, value);
@@ -33,38 +56,24 @@ void Filter::initialize(Sensor *parent, Filter *next) {
 
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MedianFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
+    const std::vector<float> &median_queue = this->window_.sorted();
+    size_t queue_size = median_queue.size();
+    if (queue_size) {
+      if (queue_size % 2) {
+        median = median_queue[queue_size / 2];
+      } else {
+        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
       }
     }
 
@@ -89,38 +98,24 @@ optional<float> SkipInitialFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), quantile_(quantile) {}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
+    const std::vector<float> &quantile_queue = this->window_.sorted();
+    size_t queue_size = quantile_queue.size();
+    if (queue_size) {
+      size_t position = ceilf(queue_size * this->quantile_) - 1;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
+      result = quantile_queue[position];
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
@@ -131,25 +126,17 @@ optional<float> QuantileFilter::new_value(float value) {
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
+    float min = this->window_.get();
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
     return min;
@@ -159,25 +146,17 @@ optional<float> MinFilter::new_value(float value) {
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
+    float max = this->window_.get();
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
     return max;
@@ -188,38 +167,36 @@ optional<float> MaxFilter::new_value(float value) {
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->window_.set_window_size(window_size);
+}
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float sum = 0;
-    size_t valid_count = 0;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        sum += v;
-        valid_count++;
-      }
-    }
-
-    float average = NAN;
-    if (valid_count) {
-      average = sum / valid_count;
-    }
+    float average = this->window_.average();
 
     ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) SENDING %f", this, value, average);
     return average;
   }
   return {};
 }
+size_t SlidingWindowMovingAverageFilter::new_values(float *values, size_t count) {
+  size_t out = 0;
+  for (size_t i = 0; i < count; i++) {
+    this->window_.push(values[i]);
+    if (++this->send_at_ >= this->send_every_) {
+      this->send_at_ = 0;
+      values[out++] = this->window_.average();
+    }
+  }
+  return out;
+}
 
 // ExponentialMovingAverageFilter
 ExponentialMovingAverageFilter::ExponentialMovingAverageFilter(float alpha, size_t send_every, size_t send_first_at)
@@ -259,7 +236,7 @@ optional<float> ThrottleAverageFilter::new_value(float value) {
   return {};
 }
 void ThrottleAverageFilter::setup() {
-  this->set_interval("throttle_average", this->time_period_, [this]() {
+  this->set_interval(THROTTLE_AVERAGE_ID, this->time_period_, [this]() {
     ESP_LOGVV(TAG, "ThrottleAverageFilter(%p)::interval(sum=%f, n=%i)", this, this->sum_, this->n_);
     if (this->n_ == 0) {
       this->output(NAN);
@@ -272,6 +249,81 @@ void ThrottleAverageFilter::setup() {
 }
 float ThrottleAverageFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
 
+// TimeWindowFilter
+TimeWindowFilter::TimeWindowFilter(uint32_t window, uint32_t send_every, TimeWindowType type, float quantile)
+    : send_every_(send_every), type_(type), quantile_(quantile), buckets_(std::max<uint32_t>(window / send_every, 1)) {
+  if (type == TIME_WINDOW_QUANTILE) {
+    const size_t bins = std::min<size_t>(std::max<size_t>(TIME_WINDOW_HISTOGRAM_BINS / this->buckets_.size(), 16), 64);
+    for (auto &bucket : this->buckets_)
+      bucket.histogram.set_max_bins(bins);
+  }
+}
+
+void TimeWindowFilter::add_(float value) {
+  if (std::isnan(value))
+    return;
+  Bucket &bucket = this->buckets_[this->current_];
+  bucket.summary.add(value);
+  if (this->type_ == TIME_WINDOW_QUANTILE)
+    bucket.histogram.add(value);
+}
+
+optional<float> TimeWindowFilter::new_value(float value) {
+  ESP_LOGVV(TAG, "TimeWindowFilter(%p)::new_value(value=%f)", this, value);
+  this->add_(value);
+  return {};
+}
+
+size_t TimeWindowFilter::new_values(float *values, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    this->add_(values[i]);
+  return 0;
+}
+
+optional<float> TimeWindowFilter::compute_() {
+  ValueSummary summary;
+  for (const auto &bucket : this->buckets_)
+    summary.merge(bucket.summary);
+  if (summary.count == 0)
+    return {};
+
+  switch (this->type_) {
+    case TIME_WINDOW_MIN:
+      return summary.min;
+    case TIME_WINDOW_MAX:
+      return summary.max;
+    case TIME_WINDOW_MEAN:
+      return summary.mean;
+    case TIME_WINDOW_STDDEV:
+      return summary.stddev();
+    case TIME_WINDOW_QUANTILE:
+    default:
+      break;
+  }
+
+  std::vector<StreamingHistogram::Bin> bins;
+  for (const auto &bucket : this->buckets_)
+    bins.insert(bins.end(), bucket.histogram.bins().begin(), bucket.histogram.bins().end());
+  std::sort(bins.begin(), bins.end(),
+            [](const StreamingHistogram::Bin &a, const StreamingHistogram::Bin &b) { return a.value < b.value; });
+  return StreamingHistogram::quantile(bins, summary.min, summary.max, this->quantile_);
+}
+
+void TimeWindowFilter::setup() {
+  this->set_interval(TIME_WINDOW_ID, this->send_every_, [this]() {
+    const optional<float> result = this->compute_();
+    ESP_LOGVV(TAG, "TimeWindowFilter(%p)::interval() -> %f", this, result.value_or(NAN));
+    // The oldest bucket leaves the window and collects the values of the next interval
+    this->current_ = (this->current_ + 1) % this->buckets_.size();
+    this->buckets_[this->current_].summary.clear();
+    this->buckets_[this->current_].histogram.clear();
+    // Without values in the window there is nothing to send, like a sensor that doesn't report
+    if (result.has_value())
+      this->output(*result);
+  });
+}
+float TimeWindowFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+
 // LambdaFilter
 LambdaFilter::LambdaFilter(lambda_filter_t lambda_filter) : lambda_filter_(std::move(lambda_filter)) {}
 const lambda_filter_t &LambdaFilter::get_lambda_filter() const { return this->lambda_filter_; }
@@ -287,11 +339,23 @@ optional<float> LambdaFilter::new_value(float value) {
 OffsetFilter::OffsetFilter(float offset) : offset_(offset) {}
 
 optional<float> OffsetFilter::new_value(float value) { return value + this->offset_; }
+size_t OffsetFilter::new_values(float *values, size_t count) {
+  const float offset = this->offset_;
+  for (size_t i = 0; i < count; i++)
+    values[i] += offset;
+  return count;
+}
 
 // MultiplyFilter
 MultiplyFilter::MultiplyFilter(float multiplier) : multiplier_(multiplier) {}
 
 optional<float> MultiplyFilter::new_value(float value) { return value * this->multiplier_; }
+size_t MultiplyFilter::new_values(float *values, size_t count) {
+  const float multiplier = this->multiplier_;
+  for (size_t i = 0; i < count; i++)
+    values[i] *= multiplier;
+  return count;
+}
 
 // FilterOutValueFilter
 FilterOutValueFilter::FilterOutValueFilter(float value_to_filter_out) : value_to_filter_out_(value_to_filter_out) {}
@@ -375,7 +439,7 @@ void OrFilter::initialize(Sensor *parent, Filter *next) {
 
 // TimeoutFilter
 optional<float> TimeoutFilter::new_value(float value) {
-  this->set_timeout("timeout", this->time_period_, [this]() { this->output(this->value_); });
+  this->set_timeout(TIMEOUT_ID, this->time_period_, [this]() { this->output(this->value_); });
   this->output(value);
 
   return {};
@@ -386,7 +450,7 @@ float TimeoutFilter::get_setup_priority() const { return setup_priority::HARDWAR
 
 // DebounceFilter
 optional<float> DebounceFilter::new_value(float value) {
-  this->set_timeout("debounce", this->time_period_, [this, value]() { this->output(value); });
+  this->set_timeout(DEBOUNCE_ID, this->time_period_, [this, value]() { this->output(value); });
 
   return {};
 }
@@ -405,7 +469,7 @@ optional<float> HeartbeatFilter::new_value(float value) {
   return {};
 }
 void HeartbeatFilter::setup() {
-  this->set_interval("heartbeat", this->time_period_, [this]() {
+  this->set_interval(HEARTBEAT_ID, this->time_period_, [this]() {
     ESP_LOGVV(TAG, "HeartbeatFilter(%p)::interval(has_value=%s, last_input=%f)", this, YESNO(this->has_value_),
               this->last_input_);
     if (!this->has_value_)
@@ -423,6 +487,16 @@ optional<float> CalibrateLinearFilter::new_value(float value) {
   }
   return NAN;
 }
+size_t CalibrateLinearFilter::new_values(float *values, size_t count) {
+  if (this->linear_functions_.size() != 1 || std::isfinite(this->linear_functions_[0][2]))
+    return Filter::new_values(values, count);
+  // A single function for all values, like with two calibration points
+  const float slope = this->linear_functions_[0][0];
+  const float offset = this->linear_functions_[0][1];
+  for (size_t i = 0; i < count; i++)
+    values[i] = (values[i] * slope) + offset;
+  return count;
+}
 
 optional<float> CalibratePolynomialFilter::new_value(float value) {
   float res = 0.0f;
@@ -444,6 +518,17 @@ optional<float> ClampFilter::new_value(float value) {
   }
   return value;
 }
+size_t ClampFilter::new_values(float *values, size_t count) {
+  // Limits that aren't finite don't clamp, comparing with an infinite one instead saves checking them for every value
+  const float min = std::isfinite(this->min_) ? this->min_ : -INFINITY;
+  const float max = std::isfinite(this->max_) ? this->max_ : INFINITY;
+  for (size_t i = 0; i < count; i++) {
+    const float value = values[i];
+    if (std::isfinite(value))
+      values[i] = value < min ? min : (value > max ? max : value);
+  }
+  return count;
+}
 
 }  // namespace sensor
 }  // namespace esphome
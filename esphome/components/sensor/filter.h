@@ -5,6 +5,7 @@
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "sliding_window.h"
 
 namespace esphome {
 namespace sensor {
@@ -29,11 +30,24 @@ class Filter {
    */
   virtual optional<float> new_value(float value) = 0;
 
+  /** This will be called instead of new_value() for blocks of values published with Sensor::publish_samples().
+   *
+   * The values are replaced in place by the ones that should be passed down the filter chain, at the front of the
+   * array, and their number is returned. The default implementation calls new_value() for each value.
+   */
+  virtual size_t new_values(float *values, size_t count);
+
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(Sensor *parent, Filter *next);
 
   void input(float value);
 
+  /** Pass a block of values through this filter and the rest of the filter chain.
+   *
+   * Returns the number of values that came out of the last filter, these are at the front of values.
+   */
+  size_t input_block(float *values, size_t count);
+
   void output(float value);
 
  protected:
@@ -67,10 +81,9 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  SortedSlidingWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
   float quantile_;
 };
 
@@ -96,10 +109,9 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SortedSlidingWindow window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple skip filter.
@@ -142,10 +154,9 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtremum<std::less<float>> window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
@@ -170,10 +181,9 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtremum<std::greater<float>> window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -194,15 +204,15 @@ class SlidingWindowMovingAverageFilter : public Filter {
   explicit SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowSum window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -247,6 +257,53 @@ class ThrottleAverageFilter : public Filter, public Component {
   unsigned int n_{0};
 };
 
+enum TimeWindowType : uint8_t {
+  TIME_WINDOW_MIN,
+  TIME_WINDOW_MAX,
+  TIME_WINDOW_MEAN,
+  TIME_WINDOW_STDDEV,
+  TIME_WINDOW_QUANTILE,
+};
+
+/// Bins of the quantile histograms of all the buckets of a window together, 16 to 64 bins per bucket.
+static const size_t TIME_WINDOW_HISTOGRAM_BINS = 512;
+
+/** Simple time window filter.
+ *
+ * Sends the minimum, maximum, mean, standard deviation or a quantile of the values received in the last window every
+ * send_every. The window is split into buckets as long as send_every that only keep a summary of their values, so the
+ * memory used doesn't grow with the sample rate. Quantiles are interpolated from a histogram per bucket. Nothing is
+ * sent while the window holds no values.
+ */
+class TimeWindowFilter : public Filter, public Component {
+ public:
+  TimeWindowFilter(uint32_t window, uint32_t send_every, TimeWindowType type, float quantile);
+
+  void setup() override;
+
+  optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
+
+  float get_setup_priority() const override;
+
+ protected:
+  struct Bucket {
+    ValueSummary summary;
+    StreamingHistogram histogram;
+  };
+
+  void add_(float value);
+  /// The result over the buckets of the window, none if they hold no values.
+  optional<float> compute_();
+
+  uint32_t send_every_;
+  TimeWindowType type_;
+  float quantile_;
+  std::vector<Bucket> buckets_;
+  /// Index of the bucket new values are added to, the oldest one is the next.
+  size_t current_{0};
+};
+
 using lambda_filter_t = std::function<optional<float>(float)>;
 
 /** This class allows for creation of simple template filters.
@@ -275,6 +332,7 @@ class OffsetFilter : public Filter {
   explicit OffsetFilter(float offset);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float offset_;
@@ -286,6 +344,7 @@ class MultiplyFilter : public Filter {
   explicit MultiplyFilter(float multiplier);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float multiplier_;
@@ -395,6 +454,7 @@ class CalibrateLinearFilter : public Filter {
   CalibrateLinearFilter(std::vector<std::array<float, 3>> linear_functions)
       : linear_functions_(std::move(linear_functions)) {}
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   std::vector<std::array<float, 3>> linear_functions_;
@@ -413,11 +473,43 @@ class ClampFilter : public Filter {
  public:
   ClampFilter(float min, float max);
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float min_{NAN};
   float max_{NAN};
 };
 
+/** Consecutive stateless filters (offset, multiply, calibrate_linear, clamp and lambda) fused into one filter.
+ *
+ * The code generator combines the steps into a single function that updates the value in place and returns false to
+ * drop it, like a lambda filter returning {}. The function is inlined here, so a value goes through all the steps
+ * without a virtual call or an optional for each one.
+ */
+template<typename Steps> class FusedFilter : public Filter {
+ public:
+  explicit FusedFilter(Steps steps) : steps_(std::move(steps)) {}
+
+  optional<float> new_value(float value) override {
+    if (!this->steps_(value))
+      return {};
+    return value;
+  }
+  size_t new_values(float *values, size_t count) override {
+    size_t out = 0;
+    for (size_t i = 0; i < count; i++) {
+      float value = values[i];
+      if (this->steps_(value))
+        values[out++] = value;
+    }
+    return out;
+  }
+
+ protected:
+  Steps steps_;
+};
+
+template<typename Steps> Filter *make_fused_filter(Steps steps) { return new FusedFilter<Steps>(std::move(steps)); }
+
 }  // namespace sensor
 }  // namespace esphome
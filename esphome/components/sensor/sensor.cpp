@@ -1,10 +1,15 @@
 #include "sensor.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace sensor {
 
 static const char *const TAG = "sensor";
+/// Number of samples passed through the filters at once by publish_samples().
+static const size_t SAMPLE_BLOCK_SIZE = 32;
 
 std::string state_class_to_string(StateClass state_class) {
   switch (state_class) {
@@ -49,6 +54,32 @@ void Sensor::publish_state(float state) {
   }
 }
 
+void Sensor::publish_samples(const float *samples, size_t count) {
+  if (count == 0)
+    return;
+  this->raw_state = samples[count - 1];
+  this->raw_callback_.call(this->raw_state);
+
+  ESP_LOGV(TAG, "'%s': Received %zu samples, last %f", this->name_.c_str(), count, this->raw_state);
+
+  if (this->filter_list_ == nullptr) {
+    this->internal_send_state_to_frontend(this->raw_state);
+    return;
+  }
+  // Filters work in place, on a copy of the samples in blocks that fit on the stack
+  float block[SAMPLE_BLOCK_SIZE];
+  optional<float> last;
+  for (size_t offset = 0; offset < count; offset += SAMPLE_BLOCK_SIZE) {
+    size_t block_size = std::min(SAMPLE_BLOCK_SIZE, count - offset);
+    memcpy(block, &samples[offset], block_size * sizeof(float));
+    block_size = this->filter_list_->input_block(block, block_size);
+    if (block_size > 0)
+      last = block[block_size - 1];
+  }
+  if (last.has_value())
+    this->internal_send_state_to_frontend(*last);
+}
+
 void Sensor::add_on_state_callback(std::function<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
 void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
   this->raw_callback_.add(std::move(callback));
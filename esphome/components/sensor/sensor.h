@@ -114,6 +114,18 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
    */
   void publish_state(float state);
 
+  /** Publish a block of samples at once, for sources that sample much faster than states are needed.
+   *
+   * The samples go through the filters as blocks, which process them in a single call each instead of once per
+   * sample. Only the last value coming out of the filter chain is sent to the front-end. The raw state is set to the
+   * last sample, and the raw state callbacks are called once with it. Filters that push out values on their own, like
+   * timeout or heartbeat, still do so one value at a time.
+   *
+   * @param samples The samples, from the oldest to the newest.
+   * @param count The number of samples.
+   */
+  void publish_samples(const float *samples, size_t count);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Add a callback that will be called every time a filtered value arrives.
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace sensor {
+
+/** Ring buffer with a fixed capacity, its storage is allocated once.
+ *
+ * Index 0 is the oldest element. Pushing to a full buffer is not allowed, pop_front() first.
+ */
+template<typename T> class FixedRingBuffer {
+ public:
+  explicit FixedRingBuffer(size_t capacity = 0) { this->set_capacity(capacity); }
+
+  /// Change the capacity, keeping the newest elements that still fit.
+  void set_capacity(size_t capacity) {
+    std::unique_ptr<T[]> data{capacity > 0 ? new T[capacity] : nullptr};
+    const size_t keep = std::min(this->size_, capacity);
+    for (size_t i = 0; i < keep; i++)
+      data[i] = (*this)[this->size_ - keep + i];
+    this->data_ = std::move(data);
+    this->capacity_ = capacity;
+    this->head_ = 0;
+    this->size_ = keep;
+  }
+  size_t capacity() const { return this->capacity_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+
+  T &operator[](size_t index) { return this->data_[this->wrap_(this->head_ + index)]; }
+  const T &operator[](size_t index) const { return this->data_[this->wrap_(this->head_ + index)]; }
+  T &front() { return (*this)[0]; }
+  const T &front() const { return (*this)[0]; }
+  T &back() { return (*this)[this->size_ - 1]; }
+  const T &back() const { return (*this)[this->size_ - 1]; }
+
+  void push_back(const T &value) {
+    this->data_[this->wrap_(this->head_ + this->size_)] = value;
+    this->size_++;
+  }
+  void pop_front() {
+    this->head_ = this->wrap_(this->head_ + 1);
+    this->size_--;
+  }
+  void pop_back() { this->size_--; }
+  void clear() {
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+
+ protected:
+  size_t wrap_(size_t index) const { return index >= this->capacity_ ? index - this->capacity_ : index; }
+
+  std::unique_ptr<T[]> data_;
+  size_t capacity_{0};
+  size_t head_{0};
+  size_t size_{0};
+};
+
+/** Sum of the last values pushed, updated with every value instead of adding up the whole window.
+ *
+ * NaN values take up room in the window but are not counted.
+ */
+class SlidingWindowSum {
+ public:
+  explicit SlidingWindowSum(size_t window_size) : values_(window_size) {}
+
+  void set_window_size(size_t window_size) {
+    this->values_.set_capacity(window_size);
+    this->recalculate_();
+  }
+  void push(float value) {
+    bool recalculate = false;
+    if (this->values_.full()) {
+      const float old = this->values_.front();
+      this->values_.pop_front();
+      if (!std::isnan(old)) {
+        this->sum_ -= old;
+        this->count_--;
+        // inf - inf is NaN, so the sum has to start over once an infinite value left the window
+        recalculate = std::isinf(old);
+      }
+    }
+    this->values_.push_back(value);
+    if (!std::isnan(value)) {
+      this->sum_ += value;
+      this->count_++;
+    }
+    // Rounding errors of the running sum add up, start over from the values once per window
+    if (recalculate || ++this->pushed_ >= this->values_.capacity())
+      this->recalculate_();
+  }
+  float sum() const { return this->sum_; }
+  /// Number of values in the window that are not NaN.
+  size_t count() const { return this->count_; }
+  float average() const { return this->count_ > 0 ? this->sum_ / this->count_ : NAN; }
+
+ protected:
+  void recalculate_() {
+    this->sum_ = 0.0f;
+    this->count_ = 0;
+    this->pushed_ = 0;
+    for (size_t i = 0; i < this->values_.size(); i++) {
+      const float value = this->values_[i];
+      if (!std::isnan(value)) {
+        this->sum_ += value;
+        this->count_++;
+      }
+    }
+  }
+
+  FixedRingBuffer<float> values_;
+  float sum_{0.0f};
+  size_t count_{0};
+  /// Values pushed since the sum was last calculated from scratch.
+  size_t pushed_{0};
+};
+
+/** Minimum (with std::less) or maximum (with std::greater) of the last values pushed.
+ *
+ * Keeps a monotonic queue of the values that can still become the extremum: from the oldest to the newest, each
+ * one more extreme than the ones after it. Every value is added and removed once, so a push takes amortized constant
+ * time and the extremum is always at the front. NaN values take up room in the window but are never the extremum.
+ */
+template<typename Compare> class SlidingWindowExtremum {
+ public:
+  explicit SlidingWindowExtremum(size_t window_size) : window_size_(window_size), queue_(window_size) {}
+
+  void set_window_size(size_t window_size) {
+    this->window_size_ = window_size;
+    this->queue_.set_capacity(window_size);
+  }
+  void push(float value) {
+    while (!this->queue_.empty() && this->index_ - this->queue_.front().index >= this->window_size_)
+      this->queue_.pop_front();
+    if (!std::isnan(value)) {
+      while (!this->queue_.empty() && !Compare()(this->queue_.back().value, value))
+        this->queue_.pop_back();
+      this->queue_.push_back(Entry{this->index_, value});
+    }
+    this->index_++;
+  }
+  /// The extremum of the window, NaN if it only holds NaN values.
+  float get() const { return this->queue_.empty() ? NAN : this->queue_.front().value; }
+
+ protected:
+  struct Entry {
+    uint32_t index;
+    float value;
+  };
+
+  size_t window_size_;
+  /// Index of the next value pushed, wrapping around is fine as only differences are used.
+  uint32_t index_{0};
+  FixedRingBuffer<Entry> queue_;
+};
+
+/** The last values pushed, and these values in sorted order for medians and quantiles.
+ *
+ * When results are taken several times per window, each push removes the value leaving the window from the sorted
+ * values and inserts the new one with a binary search, instead of sorting the whole window for every result. When
+ * results are taken less often, sorting on demand is cheaper, so the window switches between both depending on how
+ * many values were pushed since the last result. NaN values take up room in the window but are left out of the sorted
+ * values.
+ */
+class SortedSlidingWindow {
+ public:
+  explicit SortedSlidingWindow(size_t window_size) : values_(window_size) { this->sorted_.reserve(window_size); }
+
+  void set_window_size(size_t window_size) {
+    this->values_.set_capacity(window_size);
+    this->sorted_.reserve(window_size);
+    this->incremental_ = false;
+  }
+  void push(float value) {
+    if (this->values_.full()) {
+      const float old = this->values_.front();
+      this->values_.pop_front();
+      if (this->incremental_ && !std::isnan(old))
+        this->sorted_.erase(std::lower_bound(this->sorted_.begin(), this->sorted_.end(), old));
+    }
+    this->values_.push_back(value);
+    if (this->incremental_ && !std::isnan(value))
+      this->sorted_.insert(std::upper_bound(this->sorted_.begin(), this->sorted_.end(), value), value);
+    this->pushed_++;
+  }
+  /// The values in the window that are not NaN, in ascending order.
+  const std::vector<float> &sorted() {
+    if (!this->incremental_) {
+      this->sorted_.clear();
+      for (size_t i = 0; i < this->values_.size(); i++) {
+        if (!std::isnan(this->values_[i]))
+          this->sorted_.push_back(this->values_[i]);
+      }
+      std::sort(this->sorted_.begin(), this->sorted_.end());
+    }
+    // Keeping the values sorted pays off when results are taken more than about three times per window
+    this->incremental_ = this->pushed_ * 3 < this->values_.capacity();
+    this->pushed_ = 0;
+    return this->sorted_;
+  }
+
+ protected:
+  FixedRingBuffer<float> values_;
+  std::vector<float> sorted_;
+  /// Whether sorted_ is kept up to date with every push.
+  bool incremental_{false};
+  /// Values pushed since the last result.
+  size_t pushed_{0};
+};
+
+/** Count, mean, variance, minimum and maximum of values, without storing the values.
+ *
+ * The summaries of two sets of values can be merged into the summary of all of them. The variance is updated with
+ * Welford's method, which doesn't lose precision the way a sum of squares does.
+ */
+struct ValueSummary {
+  uint32_t count{0};
+  float mean{0.0f};
+  /// Sum of the squared differences from the mean.
+  float m2{0.0f};
+  float min{NAN};
+  float max{NAN};
+
+  void add(float value) {
+    this->count++;
+    const float delta = value - this->mean;
+    this->mean += delta / this->count;
+    this->m2 += delta * (value - this->mean);
+    if (this->count == 1 || value < this->min)
+      this->min = value;
+    if (this->count == 1 || value > this->max)
+      this->max = value;
+  }
+  void merge(const ValueSummary &other) {
+    if (other.count == 0)
+      return;
+    if (this->count == 0) {
+      *this = other;
+      return;
+    }
+    const uint32_t count = this->count + other.count;
+    const float delta = other.mean - this->mean;
+    this->mean += delta * other.count / count;
+    this->m2 += other.m2 + delta * delta * (float(this->count) * other.count / count);
+    this->count = count;
+    this->min = std::min(this->min, other.min);
+    this->max = std::max(this->max, other.max);
+  }
+  /// Sample standard deviation, 0 for a single value and NaN without values.
+  float stddev() const {
+    if (this->count == 0)
+      return NAN;
+    return this->count > 1 ? std::sqrt(std::max(this->m2, 0.0f) / (this->count - 1)) : 0.0f;
+  }
+  void clear() { *this = ValueSummary{}; }
+};
+
+/** Approximate distribution of values in a fixed number of bins, for quantiles of more values than can be stored.
+ *
+ * Each bin holds the mean of some values and their count. A new value gets a bin of its own, and when that makes one
+ * bin too many, the two closest bins are merged (the streaming histogram of Ben-Haim and Tom-Tov). Equal values share
+ * a bin, so the histogram is exact as long as there are no more distinct values than bins.
+ */
+class StreamingHistogram {
+ public:
+  struct Bin {
+    float value;
+    uint32_t count;
+  };
+
+  explicit StreamingHistogram(size_t max_bins = 0) { this->set_max_bins(max_bins); }
+
+  void set_max_bins(size_t max_bins) {
+    this->max_bins_ = max_bins;
+    this->bins_.reserve(max_bins + 1);
+    while (this->bins_.size() > max_bins)
+      this->merge_closest_();
+  }
+  void add(float value) {
+    auto it = std::lower_bound(this->bins_.begin(), this->bins_.end(), value,
+                               [](const Bin &bin, float value) { return bin.value < value; });
+    if (it != this->bins_.end() && it->value == value) {
+      it->count++;
+      return;
+    }
+    this->bins_.insert(it, Bin{value, 1});
+    if (this->bins_.size() > this->max_bins_)
+      this->merge_closest_();
+  }
+  /// The bins in ascending order of their values.
+  const std::vector<Bin> &bins() const { return this->bins_; }
+  void clear() { this->bins_.clear(); }
+
+  /** Quantile of the values in bins sorted by value, such as the bins of several histograms merged together.
+   *
+   * The values of a bin are taken to be spread around its mean, and the quantile is interpolated between the two
+   * closest bins. min and max are the exact extremes of the values, which are the 0 and 1 quantiles.
+   */
+  static float quantile(const std::vector<Bin> &bins, float min, float max, float quantile) {
+    uint32_t total = 0;
+    for (const auto &bin : bins)
+      total += bin.count;
+    if (total == 0)
+      return NAN;
+    const float rank = quantile * total;
+    // Interpolate between points (rank, value), starting at (0, min), with each bin in the middle of its values
+    float prev_rank = 0.0f;
+    float prev_value = min;
+    float before = 0.0f;
+    for (const auto &bin : bins) {
+      const float bin_rank = before + bin.count / 2.0f;
+      if (rank < bin_rank)
+        return interpolate_(prev_rank, prev_value, bin_rank, bin.value, rank);
+      prev_rank = bin_rank;
+      prev_value = bin.value;
+      before += bin.count;
+    }
+    return interpolate_(prev_rank, prev_value, total, max, rank);
+  }
+
+ protected:
+  static float interpolate_(float rank_a, float value_a, float rank_b, float value_b, float rank) {
+    if (rank_b <= rank_a)
+      return value_b;
+    return value_a + (value_b - value_a) * ((rank - rank_a) / (rank_b - rank_a));
+  }
+  void merge_closest_() {
+    if (this->bins_.size() < 2) {
+      this->bins_.clear();
+      return;
+    }
+    size_t closest = 0;
+    for (size_t i = 1; i + 1 < this->bins_.size(); i++) {
+      if (this->bins_[i + 1].value - this->bins_[i].value <
+          this->bins_[closest + 1].value - this->bins_[closest].value)
+        closest = i;
+    }
+    Bin &a = this->bins_[closest];
+    const Bin &b = this->bins_[closest + 1];
+    const uint32_t count = a.count + b.count;
+    a.value += (b.value - a.value) * (float(b.count) / count);
+    a.count = count;
+    this->bins_.erase(this->bins_.begin() + closest + 1);
+  }
+
+  size_t max_bins_{0};
+  std::vector<Bin> bins_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
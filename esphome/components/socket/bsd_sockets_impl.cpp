@@ -4,6 +4,10 @@
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include "esphome/core/application.h"
+#endif
+
 #include <cstring>
 
 #ifdef USE_ESP32
@@ -54,6 +58,9 @@ class BSDSocketImpl : public Socket {
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    App.unregister_socket_fd(fd_);
+#endif
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -107,6 +114,8 @@ class BSDSocketImpl : public Socket {
     return ::sendto(fd_, buf, len, flags, to, tolen);
   }
 
+  int get_fd() const override { return fd_; }
+
   int setblocking(bool blocking) override {
     int fl = ::fcntl(fd_, F_GETFL, 0);
     if (blocking) {
@@ -4,6 +4,10 @@
 #include <string>
 #include "esphome/core/log.h"
 
+#ifdef USE_HOST
+#include "esphome/components/host/core.h"
+#endif
+
 namespace esphome {
 namespace socket {
 
@@ -51,6 +55,10 @@ socklen_t set_sockaddr(struct sockaddr *addr, socklen_t addrlen, const std::stri
 }
 
 socklen_t set_sockaddr_any(struct sockaddr *addr, socklen_t addrlen, uint16_t port) {
+#ifdef USE_HOST
+  // Let several host instances listen side by side, instance N listens on the configured port + N
+  port += host::get_options().instance_id;
+#endif
 #if LWIP_IPV6
   if (addrlen < sizeof(sockaddr_in6)) {
     errno = EINVAL;
@@ -38,6 +38,9 @@ class Socket {
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+
+  /// The underlying file descriptor, or -1 if this implementation has none (e.g. raw lwIP TCP).
+  virtual int get_fd() const { return -1; }
 };
 
 /// Create a socket of the given domain, type and protocol.
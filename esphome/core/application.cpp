@@ -3,6 +3,19 @@
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include <cerrno>
+#ifdef USE_ESP32
+#include <lwip/sockets.h>
+#else
+#include <sys/select.h>
+#endif
+#endif
+
+#ifdef USE_HOST
+#include "esphome/components/host/core.h"
+#endif
+
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
@@ -10,6 +23,8 @@
 namespace esphome {
 
 static const char *const TAG = "app";
+/// Component setups taking at least this long are logged at debug level, the others at verbose level.
+static const uint32_t SETUP_TIME_REPORT_THRESHOLD_MS = 10;
 
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
@@ -32,34 +47,45 @@ void Application::setup() {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
   });
 
+  const uint32_t setup_started = millis();
   for (uint32_t i = 0; i < this->components_.size(); i++) {
     Component *component = this->components_[i];
+    const uint32_t component_started = millis();
 
     component->call();
     this->scheduler.process_to_add();
     this->feed_wdt();
-    if (component->can_proceed())
-      continue;
+    if (!component->can_proceed()) {
+      std::stable_sort(this->components_.begin(), this->components_.begin() + i + 1,
+                       [](Component *a, Component *b) { return a->get_loop_priority() > b->get_loop_priority(); });
 
-    std::stable_sort(this->components_.begin(), this->components_.begin() + i + 1,
-                     [](Component *a, Component *b) { return a->get_loop_priority() > b->get_loop_priority(); });
-
-    do {
-      uint32_t new_app_state = STATUS_LED_WARNING;
-      this->scheduler.call();
-      this->feed_wdt();
-      for (uint32_t j = 0; j <= i; j++) {
-        this->components_[j]->call();
-        new_app_state |= this->components_[j]->get_component_state();
-        this->app_state_ |= new_app_state;
+      do {
+        uint32_t new_app_state = STATUS_LED_WARNING;
+        this->scheduler.call();
         this->feed_wdt();
-      }
-      this->app_state_ = new_app_state;
-      yield();
-    } while (!component->can_proceed());
+        for (uint32_t j = 0; j <= i; j++) {
+          this->components_[j]->call();
+          new_app_state |= this->components_[j]->get_component_state();
+          this->app_state_ |= new_app_state;
+          this->feed_wdt();
+        }
+        this->app_state_ = new_app_state;
+        yield();
+      } while (!component->can_proceed());
+    }
+
+    // Includes the time spent waiting for can_proceed(), which holds back all following components
+    const uint32_t duration = millis() - component_started;
+    if (duration >= SETUP_TIME_REPORT_THRESHOLD_MS) {
+      ESP_LOGD(TAG, "Setup of %s took %u ms", component->get_component_source(), duration);
+    } else {
+      ESP_LOGV(TAG, "Setup of %s took %u ms", component->get_component_source(), duration);
+    }
   }
 
-  ESP_LOGI(TAG, "setup() finished successfully!");
+  ESP_LOGI(TAG, "setup() finished successfully in %u ms!", millis() - setup_started);
+  if (!this->async_setups_.empty())
+    ESP_LOGI(TAG, "%zu component(s) still setting up asynchronously", this->async_setups_.size());
   this->schedule_dump_config();
   this->calculate_looping_components_();
 }
@@ -68,21 +94,30 @@ void Application::loop() {
 
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
     {
+#ifdef USE_COMPONENT_PROFILER
+      WarnIfComponentBlockingGuard guard{component, &component->get_loop_stats()};
+#else
       WarnIfComponentBlockingGuard guard{component};
+#endif
       component->call();
     }
     new_app_state |= component->get_component_state();
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+  // Components with a disabled loop keep their warning and error status, like the API server without clients
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++)
+    new_app_state |= this->looping_components_[i]->get_component_state();
   this->app_state_ = new_app_state;
 
   const uint32_t now = millis();
 
   if (HighFrequencyLoopRequester::is_high_frequency()) {
-    yield();
+    this->yield_with_select_(0);
   } else {
     uint32_t delay_time = this->loop_interval_;
     if (now - this->last_loop_ < this->loop_interval_)
@@ -93,7 +128,7 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->yield_with_select_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -145,11 +180,158 @@ void Application::run_safe_shutdown_hooks() {
   }
 }
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+bool Application::register_socket_fd(int fd) {
+  if (fd < 0 || fd >= FD_SETSIZE) {
+    ESP_LOGW(TAG, "Socket fd %d out of range for select(), loop will fall back to polling it", fd);
+    return false;
+  }
+  this->socket_fds_.push_back(SocketFd{fd, nullptr});
+  this->max_fd_ = std::max(this->max_fd_, fd);
+  return true;
+}
+void Application::unregister_socket_fd(int fd) {
+  for (size_t i = 0; i < this->socket_fds_.size(); i++) {
+    if (this->socket_fds_[i].fd != fd)
+      continue;
+    if (this->socket_fds_[i].wake_component != nullptr)
+      this->socket_wake_count_--;
+    this->socket_fds_[i] = this->socket_fds_.back();
+    this->socket_fds_.pop_back();
+    if (fd == this->max_fd_) {
+      this->max_fd_ = -1;
+      for (auto &other : this->socket_fds_)
+        this->max_fd_ = std::max(this->max_fd_, other.fd);
+    }
+    return;
+  }
+}
+bool Application::set_socket_wake_component(int fd, Component *component) {
+  for (auto &entry : this->socket_fds_) {
+    if (entry.fd != fd)
+      continue;
+    if (entry.wake_component == nullptr && component != nullptr)
+      this->socket_wake_count_++;
+    if (entry.wake_component != nullptr && component == nullptr)
+      this->socket_wake_count_--;
+    entry.wake_component = component;
+    return true;
+  }
+  return false;
+}
+#endif
+
+void Application::yield_with_select_(uint32_t delay_ms) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  // Without a sleep to shorten, select() is only needed if it may have to wake up a component with a disabled loop
+  if (this->socket_fds_.empty() || (delay_ms == 0 && this->socket_wake_count_ == 0)) {
+    if (delay_ms == 0) {
+      yield();
+    } else {
+      delay(delay_ms);
+    }
+    return;
+  }
+
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+  for (auto &entry : this->socket_fds_)
+    FD_SET(entry.fd, &read_fds);
+
+  struct timeval tv;
+#ifdef USE_HOST
+  // delay_ms is on the virtual clock, which may run faster than real time
+  const uint64_t timeout_us = host::virtual_to_real_us(delay_ms * 1000ULL);
+  tv.tv_sec = timeout_us / 1000000ULL;
+  tv.tv_usec = timeout_us % 1000000ULL;
+#else
+  tv.tv_sec = delay_ms / 1000;
+  tv.tv_usec = (delay_ms % 1000) * 1000;
+#endif
+
+  // Any readable socket (new connection, incoming data, peer close) ends the sleep early so the
+  // owning component handles it in the next loop iteration instead of up to loop_interval_ later.
+  int ret = ::select(this->max_fd_ + 1, &read_fds, nullptr, nullptr, &tv);
+  if (ret < 0 && errno != EINTR) {
+    ESP_LOGV(TAG, "select() failed with errno %d", errno);
+    delay(delay_ms);
+    return;
+  }
+  if (ret > 0 && this->socket_wake_count_ != 0) {
+    for (auto &entry : this->socket_fds_) {
+      if (entry.wake_component != nullptr && FD_ISSET(entry.fd, &read_fds))
+        entry.wake_component->enable_loop();
+    }
+  }
+#else
+  if (delay_ms == 0) {
+    yield();
+  } else {
+    delay(delay_ms);
+  }
+#endif
+}
+
+void Application::async_setup_started_(Component *component) {
+  this->async_setups_.push_back(AsyncSetup{component, millis()});
+}
+void Application::async_setup_finished_(Component *component) {
+  for (size_t i = 0; i < this->async_setups_.size(); i++) {
+    if (this->async_setups_[i].component != component)
+      continue;
+    ESP_LOGD(TAG, "Asynchronous setup of %s finished after %u ms", component->get_component_source(),
+             millis() - this->async_setups_[i].started);
+    this->async_setups_[i] = this->async_setups_.back();
+    this->async_setups_.pop_back();
+    if (this->async_setups_.empty())
+      ESP_LOGI(TAG, "All components set up %u ms after boot", millis());
+    return;
+  }
+}
+
 void Application::calculate_looping_components_() {
+  // Components that disabled their loop during setup go behind the active ones
+  for (auto *obj : this->components_) {
+    if (obj->has_overridden_loop() && obj->is_loop_enabled())
+      this->looping_components_.push_back(obj);
+  }
+  this->looping_components_active_end_ = this->looping_components_.size();
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
+    if (obj->has_overridden_loop() && !obj->is_loop_enabled())
       this->looping_components_.push_back(obj);
   }
+  for (size_t i = 0; i < this->looping_components_.size(); i++)
+    this->looping_components_[i]->looping_index_ = i;
+}
+void Application::swap_looping_components_(size_t a, size_t b) {
+  std::swap(this->looping_components_[a], this->looping_components_[b]);
+  this->looping_components_[a]->looping_index_ = a;
+  this->looping_components_[b]->looping_index_ = b;
+}
+void Application::disable_component_loop_(Component *component) {
+  size_t index = component->looping_index_;
+  // Not part of the list (yet), calculate_looping_components_() picks up the flag
+  if (index >= this->looping_components_active_end_ || this->looping_components_[index] != component)
+    return;
+  if (index < this->current_loop_index_ && this->current_loop_index_ < this->looping_components_active_end_) {
+    // Already ran in this iteration: trade places with the running component first, so that only components which
+    // have not run yet are moved around below.
+    this->swap_looping_components_(index, this->current_loop_index_);
+    index = this->current_loop_index_;
+  }
+  size_t last = --this->looping_components_active_end_;
+  this->swap_looping_components_(index, last);
+  // The component swapped into the slot of the running one has not run yet in this iteration. Revisit the slot; the
+  // unsigned wrap-around for index 0 is undone by the loop increment.
+  if (index == this->current_loop_index_ && index != last)
+    this->current_loop_index_--;
+}
+void Application::enable_component_loop_(Component *component) {
+  size_t index = component->looping_index_;
+  if (index >= this->looping_components_.size() || index < this->looping_components_active_end_ ||
+      this->looping_components_[index] != component)
+    return;
+  this->swap_looping_components_(index, this->looping_components_active_end_++);
 }
 
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
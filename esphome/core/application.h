@@ -187,6 +187,8 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
@@ -319,17 +321,58 @@ class Application {
 
   Scheduler scheduler;
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  /** Register a socket file descriptor so the main loop wakes up as soon as it becomes readable.
+   *
+   * Only register sockets that are read in every loop() call of their component: a socket that holds unread data
+   * or an error stays readable and would keep the main loop from sleeping. Closing the socket unregisters it.
+   *
+   * @return Whether the descriptor could be registered, false if it is outside the range select() supports.
+   */
+  bool register_socket_fd(int fd);
+  /// Stop watching a previously registered socket file descriptor. Must be called before the fd is closed.
+  void unregister_socket_fd(int fd);
+  /** Call component->enable_loop() whenever the registered socket fd becomes readable.
+   *
+   * This lets a component disable its loop while waiting for network activity, e.g. a server without clients.
+   *
+   * @return Whether fd is registered, if false the component must keep polling in loop().
+   */
+  bool set_socket_wake_component(int fd, Component *component);
+#endif
+
  protected:
   friend Component;
 
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
+  /// Move a component behind the active part of looping_components_, see Component::disable_loop().
+  void disable_component_loop_(Component *component);
+  /// Move a component back into the active part of looping_components_, see Component::enable_loop().
+  void enable_component_loop_(Component *component);
+  void swap_looping_components_(size_t a, size_t b);
+  /// Track the duration of an asynchronous setup, see Component::begin_async_setup_().
+  void async_setup_started_(Component *component);
+  void async_setup_finished_(Component *component);
 
   void feed_wdt_arch_();
 
+  /// Sleep for up to delay_ms (just yield for 0), returning early if one of the registered sockets becomes readable.
+  void yield_with_select_(uint32_t delay_ms);
+
   std::vector<Component *> components_{};
+  /// Components overriding loop(), the ones with an enabled loop come first (up to looping_components_active_end_).
   std::vector<Component *> looping_components_{};
+  size_t looping_components_active_end_{0};
+  size_t current_loop_index_{0};
+
+  struct AsyncSetup {
+    Component *component;
+    uint32_t started;
+  };
+  /// Components that returned from setup() but are still setting up through the scheduler.
+  std::vector<AsyncSetup> async_setups_{};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -383,6 +426,15 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  struct SocketFd {
+    int fd;
+    Component *wake_component;
+  };
+  std::vector<SocketFd> socket_fds_{};
+  int max_fd_{-1};
+  size_t socket_wake_count_{0};
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -33,6 +33,8 @@ const uint32_t COMPONENT_STATE_CONSTRUCTION = 0x00;
 const uint32_t COMPONENT_STATE_SETUP = 0x01;
 const uint32_t COMPONENT_STATE_LOOP = 0x02;
 const uint32_t COMPONENT_STATE_FAILED = 0x03;
+const uint32_t COMPONENT_LOOP_DISABLED = 0x010000;
+const uint32_t COMPONENT_SETUP_PENDING = 0x020000;
 const uint32_t STATUS_LED_MASK = 0xFF00;
 const uint32_t STATUS_LED_OK = 0x0000;
 const uint32_t STATUS_LED_WARNING = 0x0100;
@@ -91,11 +93,13 @@ void Component::call() {
       // State setup: Call first loop and set state to loop
       this->component_state_ &= ~COMPONENT_STATE_MASK;
       this->component_state_ |= COMPONENT_STATE_LOOP;
-      this->call_loop();
+      if (this->is_loop_enabled())
+        this->call_loop();
       break;
     case COMPONENT_STATE_LOOP:
-      // State loop: Call loop
-      this->call_loop();
+      // State loop: Call loop, unless the component has disabled it
+      if (this->is_loop_enabled())
+        this->call_loop();
       break;
     case COMPONENT_STATE_FAILED:  // NOLINT(bugprone-branch-clone)
       // State failed: Do nothing
@@ -114,6 +118,22 @@ void Component::mark_failed() {
   this->component_state_ &= ~COMPONENT_STATE_MASK;
   this->component_state_ |= COMPONENT_STATE_FAILED;
   this->status_set_error();
+  if (this->is_setup_pending()) {
+    this->component_state_ &= ~COMPONENT_SETUP_PENDING;
+    App.async_setup_finished_(this);
+  }
+}
+void Component::begin_async_setup_() {
+  if (this->is_setup_pending())
+    return;
+  this->component_state_ |= COMPONENT_SETUP_PENDING;
+  App.async_setup_started_(this);
+}
+void Component::complete_async_setup_() {
+  if (!this->is_setup_pending())
+    return;
+  this->component_state_ &= ~COMPONENT_SETUP_PENDING;
+  App.async_setup_finished_(this);
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, "", 0, std::move(f));
@@ -134,8 +154,29 @@ void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std:
                           float backoff_increase_factor) {  // NOLINT
   App.scheduler.set_retry(this, "", initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
 }
+void Component::set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, id, timeout, std::move(f));
+}
+bool Component::cancel_timeout(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, id);
+}
+void Component::set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval(this, id, interval, std::move(f));
+}
+bool Component::cancel_interval(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_interval(this, id);
+}
+void Component::set_retry(uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                          std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor) {  // NOLINT
+  App.scheduler.set_retry(this, id, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
+}
+bool Component::cancel_retry(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_retry(this, id);
+}
 bool Component::is_failed() { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::is_ready() {
+  if (this->is_setup_pending())
+    return false;
   return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP ||
          (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_SETUP;
 }
@@ -168,6 +209,19 @@ float Component::get_actual_setup_priority() const {
 }
 void Component::set_setup_priority(float priority) { this->setup_priority_override_ = priority; }
 
+void Component::disable_loop() {
+  if (!this->is_loop_enabled())
+    return;
+  this->component_state_ |= COMPONENT_LOOP_DISABLED;
+  App.disable_component_loop_(this);
+}
+void Component::enable_loop() {
+  if (this->is_loop_enabled())
+    return;
+  this->component_state_ &= ~COMPONENT_LOOP_DISABLED;
+  App.enable_component_loop_(this);
+}
+
 bool Component::has_overridden_loop() const {
 #ifdef CLANG_TIDY
   bool loop_overridden = true;
@@ -197,7 +251,15 @@ void PollingComponent::set_update_interval(uint32_t update_interval) { this->upd
 
 WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component)
     : started_(millis()), component_(component) {}
+#ifdef USE_COMPONENT_PROFILER
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, ComponentRuntimeStats *stats)
+    : started_(millis()), component_(component), started_us_(micros()), stats_(stats) {}
+#endif
 WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {
+#ifdef USE_COMPONENT_PROFILER
+  if (this->stats_ != nullptr)
+    this->stats_->record(micros() - this->started_us_);
+#endif
   uint32_t now = millis();
   if (now - started_ > 50) {
     const char *src = component_ == nullptr ? "<null>" : component_->get_component_source();
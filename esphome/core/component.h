@@ -3,7 +3,9 @@
 #include <string>
 #include <functional>
 #include <cmath>
+#include <cstdint>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -57,6 +59,8 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_LOOP_DISABLED;
+extern const uint32_t COMPONENT_SETUP_PENDING;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -64,6 +68,22 @@ extern const uint32_t STATUS_LED_ERROR;
 
 enum class RetryResult { DONE, RETRY };
 
+#ifdef USE_COMPONENT_PROFILER
+/// Accumulated run time of one kind of call (loop() or scheduled callbacks) into a component.
+struct ComponentRuntimeStats {
+  uint32_t count{0};
+  uint64_t total_us{0};
+  uint32_t max_us{0};
+
+  void record(uint32_t duration_us) {
+    this->count++;
+    this->total_us += duration_us;
+    if (duration_us > this->max_us)
+      this->max_us = duration_us;
+  }
+};
+#endif
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -141,6 +161,22 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() until enable_loop() is called.
+   *
+   * Use this when the component has nothing to do in loop() for now, e.g. no transition is running or no client is
+   * connected. This removes the component from the list the main loop iterates over, so idle components cost nothing.
+   * Must only be called from the main loop task; it is safe to call from within loop() itself.
+   */
+  void disable_loop();
+
+  /// Resume calling loop() after disable_loop(). Cheap to call if the loop is already enabled.
+  void enable_loop();
+
+  bool is_loop_enabled() const { return (this->component_state_ & COMPONENT_LOOP_DISABLED) == 0; }
+
+  /// Whether setup() returned but the component is still setting up asynchronously, see begin_async_setup_().
+  bool is_setup_pending() const { return (this->component_state_ & COMPONENT_SETUP_PENDING) != 0; }
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -152,6 +188,13 @@ class Component {
    */
   const char *get_component_source() const;
 
+#ifdef USE_COMPONENT_PROFILER
+  /// Time spent in loop(), recorded by Application::loop().
+  ComponentRuntimeStats &get_loop_stats() { return this->loop_stats_; }
+  /// Time spent in timeouts/intervals of this component, recorded by Scheduler::call().
+  ComponentRuntimeStats &get_scheduler_stats() { return this->scheduler_stats_; }
+#endif
+
  protected:
   friend class Application;
 
@@ -178,6 +221,19 @@ class Component {
 
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /** Set an interval function identified by a numeric id instead of a name.
+   *
+   * Behaves like set_interval(const std::string &, ...) but avoids copying and comparing strings, use it in code
+   * that reschedules often. The id is typically a compile-time hash of a name, e.g. `fnv1_hash_static("update")`.
+   *
+   * @param id The identifier for this interval function.
+   * @param interval The interval in ms.
+   * @param f The function (or lambda) that should be called
+   *
+   * @see cancel_interval(uint32_t)
+   */
+  void set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   /** Cancel an interval function.
    *
    * @param name The identifier for this interval function.
@@ -185,6 +241,9 @@ class Component {
    */
   bool cancel_interval(const std::string &name);  // NOLINT
 
+  /// Cancel an interval function set with a numeric id.
+  bool cancel_interval(uint32_t id);  // NOLINT
+
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
    * This will call the retry function f on the next scheduler loop. f should return RetryResult::DONE if
@@ -221,6 +280,10 @@ class Component {
   void set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,  // NOLINT
                  float backoff_increase_factor = 1.0f);                                                      // NOLINT
 
+  /// Set a retry function identified by a numeric id, see set_interval(uint32_t, uint32_t, ...).
+  void set_retry(uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,              // NOLINT
+                 std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor = 1.0f);  // NOLINT
+
   /** Cancel a retry function.
    *
    * @param name The identifier for this retry function.
@@ -228,6 +291,9 @@ class Component {
    */
   bool cancel_retry(const std::string &name);  // NOLINT
 
+  /// Cancel a retry function set with a numeric id.
+  bool cancel_retry(uint32_t id);  // NOLINT
+
   /** Set a timeout function with a unique name.
    *
    * Similar to javascript's setTimeout(). Empty name means no cancelling possible.
@@ -246,6 +312,9 @@ class Component {
 
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /// Set a timeout function identified by a numeric id, see set_interval(uint32_t, uint32_t, ...).
+  void set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   /** Cancel a timeout function.
    *
    * @param name The identifier for this timeout function.
@@ -253,6 +322,9 @@ class Component {
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
 
+  /// Cancel a timeout function set with a numeric id.
+  bool cancel_timeout(uint32_t id);  // NOLINT
+
   /** Defer a callback to the next loop() call.
    *
    * If name is specified and a defer() object with the same name exists, the old one is first removed.
@@ -268,9 +340,26 @@ class Component {
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
 
+  /** Continue setup asynchronously after setup() returns.
+   *
+   * Call this in setup() when the remaining steps run from the scheduler, e.g. a set_timeout() chain waiting for a
+   * sensor to warm up or finish probing. Unlike overriding can_proceed(), this does not hold back the setup of the
+   * following components, so the waits of several such components overlap instead of adding up. The component is not
+   * is_ready() until complete_async_setup_() (or mark_failed()) is called, and the time taken is logged at boot.
+   */
+  void begin_async_setup_();
+
+  /// Finish an asynchronous setup started with begin_async_setup_().
+  void complete_async_setup_();
+
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
+  uint16_t looping_index_{UINT16_MAX};  ///< Position in Application::looping_components_, UINT16_MAX if not in it.
   const char *component_source_{nullptr};
+#ifdef USE_COMPONENT_PROFILER
+  ComponentRuntimeStats loop_stats_{};
+  ComponentRuntimeStats scheduler_stats_{};
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -315,11 +404,19 @@ class PollingComponent : public Component {
 class WarnIfComponentBlockingGuard {
  public:
   WarnIfComponentBlockingGuard(Component *component);
+#ifdef USE_COMPONENT_PROFILER
+  /// Additionally record the duration of the guarded call into \p stats.
+  WarnIfComponentBlockingGuard(Component *component, ComponentRuntimeStats *stats);
+#endif
   ~WarnIfComponentBlockingGuard();
 
  protected:
   uint32_t started_;
   Component *component_;
+#ifdef USE_COMPONENT_PROFILER
+  uint32_t started_us_;
+  ComponentRuntimeStats *stats_{nullptr};
+#endif
 };
 
 }  // namespace esphome
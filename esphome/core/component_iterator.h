@@ -20,6 +20,8 @@ class ComponentIterator {
  public:
   void begin(bool include_internal = false);
   void advance();
+  /// Whether the iteration was started and hasn't reached the end yet.
+  bool is_active() const { return this->state_ != IteratorState::NONE; }
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
@@ -55,6 +55,7 @@ LoopTrigger = cg.esphome_ns.class_(
 VERSION_REGEX = re.compile(r"^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$")
 
 CONF_NAME_ADD_MAC_SUFFIX = "name_add_mac_suffix"
+CONF_SCHEDULER_POOL_SIZE = "scheduler_pool_size"
 
 
 VALID_INCLUDE_EXTS = {".h", ".hpp", ".tcc", ".ino", ".cpp", ".c"}
@@ -153,6 +154,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
             cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
             cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+            cv.Optional(CONF_SCHEDULER_POOL_SIZE): cv.int_range(min=1, max=1024),
             cv.Optional(CONF_PROJECT): cv.Schema(
                 {
                     cv.Required(CONF_NAME): cv.All(
@@ -386,6 +388,10 @@ async def to_code(config):
     if config[CONF_INCLUDES]:
         CORE.add_job(add_includes, config[CONF_INCLUDES])
 
+    if CONF_SCHEDULER_POOL_SIZE in config:
+        cg.add_define("USE_SCHEDULER_POOL")
+        cg.add_define("ESPHOME_SCHEDULER_POOL_SIZE", config[CONF_SCHEDULER_POOL_SIZE])
+
     if CONF_PROJECT in config:
         cg.add_define("ESPHOME_PROJECT_NAME", config[CONF_PROJECT][CONF_NAME])
         cg.add_define("ESPHOME_PROJECT_VERSION", config[CONF_PROJECT][CONF_VERSION])
@@ -15,12 +15,16 @@
 
 // Feature flags
 #define USE_API
+#define USE_API_CONNECTION_STATS
 #define USE_API_NOISE
+#define USE_API_NOISE_RESUMPTION
 #define USE_API_PLAINTEXT
+#define USE_API_SENSOR_BATCH
 #define USE_ALARM_CONTROL_PANEL
 #define USE_BINARY_SENSOR
 #define USE_BUTTON
 #define USE_CLIMATE
+#define USE_COMPONENT_PROFILER
 #define USE_COVER
 #define USE_DEEP_SLEEP
 #define USE_FAN
@@ -38,7 +42,10 @@
 #define USE_OTA_PASSWORD
 #define USE_OTA_STATE_CALLBACK
 #define USE_POWER_SUPPLY
+#define USE_PREFERENCES_COALESCING
 #define USE_QR_CODE
+#define USE_SCHEDULER_POOL
+#define ESPHOME_SCHEDULER_POOL_SIZE 16  // NOLINT
 #define USE_SELECT
 #define USE_SENSOR
 #define USE_STATUS_LED
@@ -70,7 +77,9 @@
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
+#define USE_LOGGER_RING_BUFFER
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #define USE_WIFI_11KV_SUPPORT
 #define USE_BLUETOOTH_PROXY
 #define USE_VOICE_ASSISTANT
@@ -110,6 +119,7 @@
 
 #ifdef USE_HOST
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #endif
 
 // Disabled feature flags
@@ -35,6 +35,8 @@ namespace esphome {
 
 void yield();
 uint32_t millis();
+/// Milliseconds since boot as a 64-bit value, which (unlike millis()) never wraps around.
+uint64_t millis_64();
 uint32_t micros();
 void delay(uint32_t ms);
 void delayMicroseconds(uint32_t us);  // NOLINT(readability-identifier-naming)
@@ -33,6 +33,7 @@
 #elif defined(USE_HOST)
 #include <limits>
 #include <random>
+#include "esphome/components/host/core.h"
 #endif
 #ifdef USE_ESP32
 #include "esp32/rom/crc.h"
@@ -555,6 +556,15 @@ void get_mac_address_raw(uint8_t *mac) {  // NOLINT(readability-non-const-parame
   wifi_get_macaddr(STATION_IF, mac);
 #elif defined(USE_RP2040) && defined(USE_WIFI)
   WiFi.macAddress(mac);
+#elif defined(USE_HOST)
+  // Locally administered address, distinct for every instance running on the same machine
+  const uint16_t instance_id = host::get_options().instance_id;
+  mac[0] = 0x02;
+  mac[1] = 0x00;
+  mac[2] = 0x00;
+  mac[3] = 0x00;
+  mac[4] = instance_id >> 8;
+  mac[5] = instance_id & 0xFF;
 #endif
 }
 std::string get_mac_address() {
@@ -163,6 +163,11 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc = 0, uint16_t p
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
 
+/// Calculate a FNV-1 hash of \p str at compile time, giving the same result as fnv1_hash().
+constexpr uint32_t fnv1_hash_static(const char *str, uint32_t hash = 2166136261UL) {
+  return *str == '\0' ? hash : fnv1_hash_static(str + 1, (hash * 16777619UL) ^ *str);
+}
+
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
 /// Return a random float between 0 and 1.
@@ -10,6 +10,8 @@ namespace esphome {
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+// Retries with an id run as timeouts, keep them apart from plain timeouts with the same id
+static const uint32_t RETRY_ID_SALT = fnv1_hash_static("retry$");
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -19,65 +21,80 @@ static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 // iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
 // avoid the main thread modifying the list while it is being accessed.
 
+#ifdef USE_SCHEDULER_POOL
+Scheduler::Scheduler() {
+  this->pool_.reserve(ESPHOME_SCHEDULER_POOL_SIZE);
+  for (uint32_t i = 0; i < ESPHOME_SCHEDULER_POOL_SIZE; i++)
+    this->pool_.push_back(make_unique<SchedulerItem>());
+}
+#endif
+
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> func) {
-  const uint32_t now = this->millis_();
-
-  if (!name.empty())
-    this->cancel_timeout(component, name);
-
-  if (timeout == SCHEDULER_DONT_RUN)
-    return;
-
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
-
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
-  item->timeout = timeout;
-  item->last_execution = now;
-  item->last_execution_major = this->millis_major_;
-  item->callback = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+  this->set_item_(component, SchedulerItem::TIMEOUT, &name, fnv1_hash(name), timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t id, uint32_t timeout, std::function<void()> func) {
+  this->set_item_(component, SchedulerItem::TIMEOUT, nullptr, id, timeout, std::move(func));
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_item_(component, &name, fnv1_hash(name), SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t id) {
+  return this->cancel_item_(component, nullptr, id, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> func) {
-  const uint32_t now = this->millis_();
+  this->set_item_(component, SchedulerItem::INTERVAL, &name, fnv1_hash(name), interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, uint32_t id, uint32_t interval, std::function<void()> func) {
+  this->set_item_(component, SchedulerItem::INTERVAL, nullptr, id, interval, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, &name, fnv1_hash(name), SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t id) {
+  return this->cancel_item_(component, nullptr, id, SchedulerItem::INTERVAL);
+}
+void HOT Scheduler::set_item_(Component *component, SchedulerItem::Type type, const std::string *name,
+                              uint32_t name_hash, uint32_t delay, std::function<void()> func) {
+  const uint64_t now = millis_64();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (name == nullptr || !name->empty())
+    this->cancel_item_(component, name, name_hash, type);
 
-  if (interval == SCHEDULER_DONT_RUN)
+  if (delay == SCHEDULER_DONT_RUN)
     return;
 
   // only put offset in lower half
   uint32_t offset = 0;
-  if (interval != 0)
-    offset = (random_uint32() % interval) / 2;
+  if (type == SchedulerItem::INTERVAL && delay != 0)
+    offset = (random_uint32() % delay) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
-
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->make_item_();
   item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
-  item->interval = interval;
-  item->last_execution = now - offset - interval;
-  item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
+  if (name == nullptr) {
+    item->name.clear();
+  } else {
+    item->name = *name;
+  }
+  item->name_hash = name_hash;
+  item->named_by_id = name == nullptr;
+  item->type = type;
+  item->interval = delay;
+  if (type == SchedulerItem::INTERVAL) {
+    // first run right away, the offset only shifts the phase of the following runs
+    item->next_execution = now > offset ? now - offset : 0;
+  } else {
+    item->next_execution = now + delay;
+  }
   item->callback = std::move(func);
   item->remove = false;
+
+  ESP_LOGVV(TAG, "set_%s(name='%s', id=0x%08" PRIX32 ", delay=%" PRIu32 ", offset=%" PRIu32 ")", item->get_type_str(),
+            item->name.c_str(), name_hash, delay, offset);
+
   this->push_(std::move(item));
 }
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
-}
 
 struct RetryArgs {
   std::function<RetryResult(uint8_t)> func;
@@ -85,6 +102,8 @@ struct RetryArgs {
   uint32_t current_interval;
   Component *component;
   std::string name;
+  uint32_t id;
+  bool named_by_id;
   float backoff_increase_factor;
   Scheduler *scheduler;
 };
@@ -94,7 +113,12 @@ static void retry_handler(const std::shared_ptr<RetryArgs> &args) {
   if (retry_result == RetryResult::DONE || args->retry_countdown <= 0)
     return;
   // second execution of `func` happens after `initial_wait_time`
-  args->scheduler->set_timeout(args->component, args->name, args->current_interval, [args]() { retry_handler(args); });
+  if (args->named_by_id) {
+    args->scheduler->set_timeout(args->component, args->id, args->current_interval, [args]() { retry_handler(args); });
+  } else {
+    args->scheduler->set_timeout(args->component, args->name, args->current_interval,
+                                 [args]() { retry_handler(args); });
+  }
   // backoff_increase_factor applied to third & later executions
   args->current_interval *= args->backoff_increase_factor;
 }
@@ -105,65 +129,84 @@ void HOT Scheduler::set_retry(Component *component, const std::string &name, uin
   if (!name.empty())
     this->cancel_retry(component, name);
 
+  auto args = std::make_shared<RetryArgs>();
+  args->name = "retry$" + name;
+  args->named_by_id = false;
+  this->start_retry_(component, args, initial_wait_time, max_attempts, std::move(func), backoff_increase_factor);
+}
+void HOT Scheduler::set_retry(Component *component, uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                              std::function<RetryResult(uint8_t)> func, float backoff_increase_factor) {
+  this->cancel_retry(component, id);
+
+  auto args = std::make_shared<RetryArgs>();
+  args->id = id ^ RETRY_ID_SALT;
+  args->named_by_id = true;
+  this->start_retry_(component, args, initial_wait_time, max_attempts, std::move(func), backoff_increase_factor);
+}
+void Scheduler::start_retry_(Component *component, const std::shared_ptr<RetryArgs> &args, uint32_t initial_wait_time,
+                             uint8_t max_attempts, std::function<RetryResult(uint8_t)> func,
+                             float backoff_increase_factor) {
   if (initial_wait_time == SCHEDULER_DONT_RUN)
     return;
 
   ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%" PRIu32 ", max_attempts=%u, backoff_factor=%0.1f)",
-            name.c_str(), initial_wait_time, max_attempts, backoff_increase_factor);
+            args->name.c_str(), initial_wait_time, max_attempts, backoff_increase_factor);
 
   if (backoff_increase_factor < 0.0001) {
     ESP_LOGE(TAG,
              "set_retry(name='%s'): backoff_factor cannot be close to zero nor negative (%0.1f). Using 1.0 instead",
-             name.c_str(), backoff_increase_factor);
+             args->name.c_str(), backoff_increase_factor);
     backoff_increase_factor = 1;
   }
 
-  auto args = std::make_shared<RetryArgs>();
   args->func = std::move(func);
   args->retry_countdown = max_attempts;
   args->current_interval = initial_wait_time;
   args->component = component;
-  args->name = "retry$" + name;
   args->backoff_increase_factor = backoff_increase_factor;
   args->scheduler = this;
 
   // First execution of `func` immediately
-  this->set_timeout(component, args->name, 0, [args]() { retry_handler(args); });
+  if (args->named_by_id) {
+    this->set_timeout(component, args->id, 0, [args]() { retry_handler(args); });
+  } else {
+    this->set_timeout(component, args->name, 0, [args]() { retry_handler(args); });
+  }
 }
 bool HOT Scheduler::cancel_retry(Component *component, const std::string &name) {
   return this->cancel_timeout(component, "retry$" + name);
 }
+bool HOT Scheduler::cancel_retry(Component *component, uint32_t id) {
+  return this->cancel_timeout(component, id ^ RETRY_ID_SALT);
+}
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
   if (this->empty_())
     return {};
   auto &item = this->items_[0];
-  const uint32_t now = this->millis_();
-  uint32_t next_time = item->last_execution + item->interval;
-  if (next_time < now)
+  const uint64_t now = millis_64();
+  if (item->next_execution <= now)
     return 0;
-  return next_time - now;
+  return static_cast<uint32_t>(std::min<uint64_t>(item->next_execution - now, UINT32_MAX));
 }
 void HOT Scheduler::call() {
-  const uint32_t now = this->millis_();
+  const uint64_t now = millis_64();
   this->process_to_add();
 
 #ifdef ESPHOME_DEBUG_SCHEDULER
-  static uint32_t last_print = 0;
+  static uint64_t last_print = 0;
 
   if (now - last_print > 2000) {
     last_print = now;
     std::vector<std::unique_ptr<SchedulerItem>> old_items;
-    ESP_LOGVV(TAG, "Items: count=%u, now=%" PRIu32, this->items_.size(), now);
+    ESP_LOGVV(TAG, "Items: count=%u, now=%" PRIu64, this->items_.size(), now);
     while (!this->empty_()) {
       this->lock_.lock();
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
+      auto item = this->pop_raw_();
       this->lock_.unlock();
 
-      ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
-                item->last_execution_major, item->next_execution(), item->next_execution_major());
+      ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " next_execution=%" PRIu64, item->get_type_str(),
+                item->name.c_str(), item->interval, item->next_execution);
 
       old_items.push_back(std::move(item));
     }
@@ -180,17 +223,17 @@ void HOT Scheduler::call() {
   auto items_was = this->items_.size();
   // If we have too many items to remove
   if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
-    std::vector<std::unique_ptr<SchedulerItem>> valid_items;
-    while (!this->empty_()) {
-      LockGuard guard{this->lock_};
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
-    }
-
+    // Drop the cancelled items in place and restore the heap, rebuilding the vector would allocate every time
     {
       LockGuard guard{this->lock_};
-      this->items_ = std::move(valid_items);
+      auto removed = std::partition(this->items_.begin(), this->items_.end(),
+                                    [](const std::unique_ptr<SchedulerItem> &item) { return !item->remove; });
+      for (auto it = removed; it != this->items_.end(); ++it) {
+        to_remove_--;
+        this->recycle_item_(std::move(*it));
+      }
+      this->items_.erase(removed, this->items_.end());
+      std::make_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
     }
 
     // The following should not happen unless I'm missing something
@@ -206,31 +249,33 @@ void HOT Scheduler::call() {
     {
       // Don't copy-by value yet
       auto &item = this->items_[0];
-      if ((now - item->last_execution) < item->interval) {
+      if (item->next_execution > now) {
         // Not reached timeout yet, done for this call
         break;
       }
-      uint8_t major = item->next_execution_major();
-      if (this->millis_major_ - major > 1)
-        break;
 
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
         LockGuard guard{this->lock_};
-        this->pop_raw_();
+        this->recycle_item_(this->pop_raw_());
         continue;
       }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+      ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " next_execution=%" PRIu64 " (now=%" PRIu64 ")",
+                item->get_type_str(), item->name.c_str(), item->interval, item->next_execution, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
       {
+#ifdef USE_COMPONENT_PROFILER
+        WarnIfComponentBlockingGuard guard{
+            item->component, item->component != nullptr ? &item->component->get_scheduler_stats() : nullptr};
+#else
         WarnIfComponentBlockingGuard guard{item->component};
+#endif
         item->callback();
       }
     }
@@ -239,29 +284,31 @@ void HOT Scheduler::call() {
       this->lock_.lock();
 
       // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
-
       // Only pop after function call, this ensures we were reachable
       // during the function call and know if we were cancelled.
-      this->pop_raw_();
+      auto item = this->pop_raw_();
 
       this->lock_.unlock();
 
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
         to_remove_--;
+        LockGuard guard{this->lock_};
+        this->recycle_item_(std::move(item));
         continue;
       }
 
       if (item->type == SchedulerItem::INTERVAL) {
         if (item->interval != 0) {
-          const uint32_t before = item->last_execution;
-          const uint32_t amount = (now - item->last_execution) / item->interval;
-          item->last_execution += amount * item->interval;
-          if (item->last_execution < before)
-            item->last_execution_major++;
+          // skip runs we missed, the next one is the first deadline after now
+          const uint64_t amount = (now - item->next_execution) / item->interval + 1;
+          item->next_execution += amount * item->interval;
         }
-        this->push_(std::move(item));
+        LockGuard guard{this->lock_};
+        this->to_add_.push_back(std::move(item));
+      } else {
+        LockGuard guard{this->lock_};
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -272,6 +319,8 @@ void HOT Scheduler::process_to_add() {
   LockGuard guard{this->lock_};
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      to_remove_--;
+      this->recycle_item_(std::move(it));
       continue;
     }
 
@@ -290,31 +339,60 @@ void HOT Scheduler::cleanup_() {
 
     {
       LockGuard guard{this->lock_};
-      this->pop_raw_();
+      this->recycle_item_(this->pop_raw_());
     }
   }
 }
-void HOT Scheduler::pop_raw_() {
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_() {
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+  auto item = std::move(this->items_.back());
   this->items_.pop_back();
+  return item;
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
   LockGuard guard{this->lock_};
+#ifdef USE_SCHEDULER_POOL
+  if (item->is_cancellable())
+    this->index_insert_(item.get());
+#endif
   this->to_add_.push_back(std::move(item));
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::matches_(SchedulerItem *item, Component *component, const std::string *name, uint32_t name_hash,
+                             SchedulerItem::Type type) {
+  // compare the precomputed hash first, the string compare only confirms a (likely) match
+  if (item->component != component || item->name_hash != name_hash || item->type != type || item->remove)
+    return false;
+  if (name == nullptr)
+    return item->named_by_id;
+  return !item->named_by_id && item->name == *name;
+}
+bool HOT Scheduler::cancel_item_(Component *component, const std::string *name, uint32_t name_hash,
+                                 Scheduler::SchedulerItem::Type type) {
   // obtain lock because this function iterates and can be called from non-loop task context
   LockGuard guard{this->lock_};
   bool ret = false;
+#ifdef USE_SCHEDULER_POOL
+  if (name == nullptr || !name->empty()) {
+    for (auto *it = this->index_[index_bucket_(component, name_hash)]; it != nullptr; it = it->index_next) {
+      if (this->matches_(it, component, name, name_hash, type)) {
+        to_remove_++;
+        it->remove = true;
+        ret = true;
+      }
+    }
+    return ret;
+  }
+#endif
   for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+    if (this->matches_(it.get(), component, name, name_hash, type)) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
   }
   for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
+    if (this->matches_(it.get(), component, name, name_hash, type)) {
+      to_remove_++;
       it->remove = true;
       ret = true;
     }
@@ -322,43 +400,57 @@ bool HOT Scheduler::cancel_item_(Component *component, const std::string &name,
 
   return ret;
 }
-uint32_t Scheduler::millis_() {
-  const uint32_t now = millis();
-  if (now < this->last_millis_) {
-    ESP_LOGD(TAG, "Incrementing scheduler major");
-    this->millis_major_++;
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::make_item_() {
+#ifdef USE_SCHEDULER_POOL
+  {
+    LockGuard guard{this->lock_};
+    if (!this->pool_.empty()) {
+      auto item = std::move(this->pool_.back());
+      this->pool_.pop_back();
+      return item;
+    }
   }
-  this->last_millis_ = now;
-  return now;
+#endif
+  return make_unique<SchedulerItem>();
 }
-
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+#ifdef USE_SCHEDULER_POOL
+  // release everything the callback captured right away, not when the item is reused
+  item->callback = nullptr;
+  if (item->is_cancellable())
+    this->index_remove_(item.get());
+  // keep the name's buffer around, assigning a name of similar length later won't allocate
+  if (this->pool_.size() < ESPHOME_SCHEDULER_POOL_SIZE)
+    this->pool_.push_back(std::move(item));
+#endif
+}
+#ifdef USE_SCHEDULER_POOL
+uint32_t Scheduler::index_bucket_(Component *component, uint32_t name_hash) {
+  auto ptr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(component));
+  return (name_hash ^ (ptr >> 2)) % INDEX_BUCKETS;
+}
+void Scheduler::index_insert_(SchedulerItem *item) {
+  auto &head = this->index_[index_bucket_(item->component, item->name_hash)];
+  item->index_next = head;
+  head = item;
+}
+void Scheduler::index_remove_(SchedulerItem *item) {
+  SchedulerItem **it = &this->index_[index_bucket_(item->component, item->name_hash)];
+  while (*it != nullptr) {
+    if (*it == item) {
+      *it = item->index_next;
+      item->index_next = nullptr;
+      return;
+    }
+    it = &(*it)->index_next;
+  }
+}
+#endif
 bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
                                        const std::unique_ptr<SchedulerItem> &b) {
   // min-heap
   // return true if *a* will happen after *b*
-  uint32_t a_next_exec = a->next_execution();
-  uint8_t a_next_exec_major = a->next_execution_major();
-  uint32_t b_next_exec = b->next_execution();
-  uint8_t b_next_exec_major = b->next_execution_major();
-
-  if (a_next_exec_major != b_next_exec_major) {
-    // The "major" calculation is quite complicated.
-    // Basically, we need to check if the major value lies in the future or
-    //
-
-    // Here are some cases to think about:
-    // Format: a_major,b_major -> expected result (a-b, b-a)
-    // a=255,b=0 -> false (255, 1)
-    // a=0,b=1 -> false   (255, 1)
-    // a=1,b=0 -> true    (1, 255)
-    // a=0,b=255 -> true  (1, 255)
-
-    uint8_t diff1 = a_next_exec_major - b_next_exec_major;
-    uint8_t diff2 = b_next_exec_major - a_next_exec_major;
-    return diff1 < diff2;
-  }
-
-  return a_next_exec > b_next_exec;
+  return a->next_execution > b->next_execution;
 }
 
 }  // namespace esphome
@@ -4,14 +4,20 @@
 #include <memory>
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 
 namespace esphome {
 
 class Component;
+struct RetryArgs;
 
 class Scheduler {
  public:
+#ifdef USE_SCHEDULER_POOL
+  Scheduler();
+#endif
+
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
   bool cancel_timeout(Component *component, const std::string &name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
@@ -21,6 +27,17 @@ class Scheduler {
                  std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
   bool cancel_retry(Component *component, const std::string &name);
 
+  // Variants identified by a numeric id instead of a name, usually `fnv1_hash_static("name")`. These don't copy or
+  // compare any strings. Ids are separate from names: an id never matches an item set by name.
+  void set_timeout(Component *component, uint32_t id, uint32_t timeout, std::function<void()> func);
+  bool cancel_timeout(Component *component, uint32_t id);
+  void set_interval(Component *component, uint32_t id, uint32_t interval, std::function<void()> func);
+  bool cancel_interval(Component *component, uint32_t id);
+
+  void set_retry(Component *component, uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                 std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
+  bool cancel_retry(Component *component, uint32_t id);
+
   optional<uint32_t> next_schedule_in();
 
   void call();
@@ -31,24 +48,22 @@ class Scheduler {
   struct SchedulerItem {
     Component *component;
     std::string name;
+    uint32_t name_hash;  ///< Hash of `name`, or the id for items set by id.
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
       uint32_t timeout;
     };
-    uint32_t last_execution;
+    uint64_t next_execution;  ///< Deadline on the millis_64() time base.
     std::function<void()> callback;
     bool remove;
-    uint8_t last_execution_major;
-
-    inline uint32_t next_execution() { return this->last_execution + this->timeout; }
-    inline uint8_t next_execution_major() {
-      uint32_t next_exec = this->next_execution();
-      uint8_t next_exec_major = this->last_execution_major;
-      if (next_exec < this->last_execution)
-        next_exec_major++;
-      return next_exec_major;
-    }
+    bool named_by_id;
+#ifdef USE_SCHEDULER_POOL
+    SchedulerItem *index_next;  ///< Next item in the same bucket of the cancel index.
+#endif
+
+    /// Items without name or id can't be cancelled individually.
+    inline bool is_cancellable() const { return this->named_by_id || !this->name.empty(); }
 
     static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b);
     const char *get_type_str() {
@@ -63,11 +78,26 @@ class Scheduler {
     }
   };
 
-  uint32_t millis_();
   void cleanup_();
-  void pop_raw_();
+  std::unique_ptr<SchedulerItem> pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  /// Schedule an item, `name` is nullptr for items set by id.
+  void set_item_(Component *component, SchedulerItem::Type type, const std::string *name, uint32_t name_hash,
+                 uint32_t delay, std::function<void()> func);
+  void start_retry_(Component *component, const std::shared_ptr<RetryArgs> &args, uint32_t initial_wait_time,
+                    uint8_t max_attempts, std::function<RetryResult(uint8_t)> func, float backoff_increase_factor);
+  bool cancel_item_(Component *component, const std::string *name, uint32_t name_hash, SchedulerItem::Type type);
+  bool matches_(SchedulerItem *item, Component *component, const std::string *name, uint32_t name_hash,
+                SchedulerItem::Type type);
+  /// Get an item, recycled from the pool if possible.
+  std::unique_ptr<SchedulerItem> make_item_();
+  /// Release an item that is no longer in any container, returning it to the pool if possible. Requires `lock_`.
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
+#ifdef USE_SCHEDULER_POOL
+  static uint32_t index_bucket_(Component *component, uint32_t name_hash);
+  void index_insert_(SchedulerItem *item);
+  void index_remove_(SchedulerItem *item);
+#endif
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -76,9 +106,14 @@ class Scheduler {
   Mutex lock_;
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
-  uint32_t last_millis_{0};
-  uint8_t millis_major_{0};
   uint32_t to_remove_{0};
+#ifdef USE_SCHEDULER_POOL
+  static const uint32_t INDEX_BUCKETS = 32;
+  /// Spare items, allocated up front and reused so that set_timeout()/set_interval() don't hit the heap.
+  std::vector<std::unique_ptr<SchedulerItem>> pool_;
+  /// Named items (in `items_`, `to_add_` or currently running) chained by (component, name hash) for cancelling.
+  SchedulerItem *index_[INDEX_BUCKETS]{};
+#endif
 };
 
 }  // namespace esphome
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""Measure how fast a node sends its entities over the native API.
+
+Connects to a running node (for example a host platform build started with
+script/host_harness.py) and times the two bulk transfers of a connection:
+the entity list sent for list_entities and the initial states sent after
+subscribe_states. Both are reported as entities per second.
+
+Example:
+    script/api_benchmark.py 127.0.0.1 --port 6053 -r 20
+"""
+import argparse
+import asyncio
+import statistics
+import sys
+import time
+
+from aioesphomeapi import APIClient, ButtonInfo
+
+
+async def run_once(args):
+    client = APIClient(
+        args.address, args.port, args.password, noise_psk=args.noise_psk
+    )
+    await client.connect(login=True)
+    try:
+        started = time.perf_counter()
+        entities, _ = await client.list_entities_services()
+        list_time = time.perf_counter() - started
+
+        # Buttons have no state, every other entity sends one initial state
+        expected = {e.key for e in entities if not isinstance(e, ButtonInfo)}
+        received = set()
+        done = asyncio.Event()
+
+        def on_state(state):
+            received.add(state.key)
+            if received >= expected:
+                done.set()
+
+        started = time.perf_counter()
+        await client.subscribe_states(on_state)
+        if expected:
+            await asyncio.wait_for(done.wait(), args.timeout)
+        state_time = time.perf_counter() - started
+    finally:
+        await client.disconnect()
+    return len(entities), list_time, len(expected), state_time
+
+
+def print_result(name, count, times):
+    rates = [count / t for t in times if t > 0]
+    if not rates:
+        return
+    print(
+        f"{name:>16}: {count:>4} entities, "
+        f"median {statistics.median(rates):>9.1f} entities/s "
+        f"(min {min(rates):.1f}, max {max(rates):.1f}), "
+        f"median {1000 * statistics.median(times):.1f} ms"
+    )
+
+
+async def main_async(args):
+    list_times = []
+    state_times = []
+    entity_count = state_count = 0
+    for _ in range(args.runs):
+        entity_count, list_time, state_count, state_time = await run_once(args)
+        list_times.append(list_time)
+        state_times.append(state_time)
+    print_result("list_entities", entity_count, list_times)
+    print_result("subscribe_states", state_count, state_times)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("address", help="address of the node")
+    parser.add_argument("--port", type=int, default=6053, help="API port")
+    parser.add_argument("--password", default="", help="API password")
+    parser.add_argument("--noise-psk", help="API encryption key")
+    parser.add_argument(
+        "-r", "--runs", type=int, default=10, help="number of connections to time"
+    )
+    parser.add_argument(
+        "--timeout",
+        type=float,
+        default=30,
+        help="seconds to wait for all initial states",
+    )
+    args = parser.parse_args()
+    asyncio.run(main_async(args))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
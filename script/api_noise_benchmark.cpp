@@ -0,0 +1,259 @@
+// Benchmark of the native API encryption on the host, using noise-c directly.
+//
+// Compares a full Noise_NNpsk0 handshake with deriving the keys of a resumed session, and encrypting packets into a
+// newly allocated frame with encrypting them in place into a reused buffer, the way APINoiseFrameHelper does. Before
+// that it checks that a client and the server derive the same keys for a resumed session, by sending a frame each
+// way through them. Exits with 1 if that fails.
+//
+// Build and run with noise-c (https://github.com/rweather/noise-c) installed:
+//     g++ -std=gnu++17 -O2 script/api_noise_benchmark.cpp -lnoiseprotocol -o api_noise_benchmark
+//     ./api_noise_benchmark
+
+#include <noise/protocol.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+static const char *const PROTOCOL = "Noise_NNpsk0_25519_ChaChaPoly_SHA256";
+static const uint8_t PSK[32] = {0x6c, 0xe1, 0x45, 0xcf, 0x3b, 0x96, 0xa7, 0x0e, 0x4b, 0x3d, 0x15,
+                                0x37, 0x28, 0x21, 0x53, 0x88, 0x7d, 0x2c, 0xd8, 0x22, 0x91, 0x30,
+                                0xae, 0xbf, 0x57, 0x24, 0x8b, 0x10, 0x30, 0xd4, 0x51, 0x9a};
+static const char PROLOGUE[] = "NoiseAPIInit";
+
+static void check(int err, const char *what) {
+  if (err != NOISE_ERROR_NONE) {
+    char buf[64];
+    noise_strerror(err, buf, sizeof(buf));
+    fprintf(stderr, "%s failed: %s\n", what, buf);
+    exit(1);
+  }
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static NoiseHandshakeState *new_handshake(int role) {
+  NoiseHandshakeState *state;
+  check(noise_handshakestate_new_by_name(&state, PROTOCOL, role), "noise_handshakestate_new_by_name");
+  check(noise_handshakestate_set_pre_shared_key(state, PSK, sizeof(PSK)), "noise_handshakestate_set_pre_shared_key");
+  check(noise_handshakestate_set_prologue(state, PROLOGUE, sizeof(PROLOGUE) - 1), "noise_handshakestate_set_prologue");
+  check(noise_handshakestate_start(state), "noise_handshakestate_start");
+  return state;
+}
+
+/// Run a full handshake between an initiator and a responder, returns the ciphers of the responder.
+static void handshake(NoiseCipherState **send, NoiseCipherState **recv) {
+  NoiseHandshakeState *initiator = new_handshake(NOISE_ROLE_INITIATOR);
+  NoiseHandshakeState *responder = new_handshake(NOISE_ROLE_RESPONDER);
+  uint8_t message[128];
+  NoiseHandshakeState *writer = initiator;
+  NoiseHandshakeState *reader = responder;
+  while (noise_handshakestate_get_action(responder) != NOISE_ACTION_SPLIT) {
+    NoiseBuffer mbuf;
+    noise_buffer_set_output(mbuf, message, sizeof(message));
+    check(noise_handshakestate_write_message(writer, &mbuf, nullptr), "noise_handshakestate_write_message");
+    noise_buffer_set_input(mbuf, message, mbuf.size);
+    check(noise_handshakestate_read_message(reader, &mbuf, nullptr), "noise_handshakestate_read_message");
+    std::swap(writer, reader);
+  }
+  check(noise_handshakestate_split(responder, send, recv), "noise_handshakestate_split");
+  noise_handshakestate_free(initiator);
+  noise_handshakestate_free(responder);
+}
+
+/** Run a full handshake in which the server sends a ticket, like APINoiseFrameHelper with a client hello of 0x01.
+ *
+ * Returns the ticket id the client received, and the ticket secret both sides derive from the handshake hash.
+ */
+static void issue_ticket(uint8_t *ticket_id, uint8_t *client_secret, uint8_t *server_secret) {
+  NoiseHandshakeState *initiator = new_handshake(NOISE_ROLE_INITIATOR);
+  NoiseHandshakeState *responder = new_handshake(NOISE_ROLE_RESPONDER);
+  uint8_t server_ticket_id[16];
+  for (size_t i = 0; i < sizeof(server_ticket_id); i++)
+    server_ticket_id[i] = (uint8_t) rand();  // NOLINT(cert-msc30-c,cert-msc50-cpp)
+  uint8_t message[128];
+  NoiseBuffer mbuf;
+  noise_buffer_set_output(mbuf, message, sizeof(message));
+  check(noise_handshakestate_write_message(initiator, &mbuf, nullptr), "noise_handshakestate_write_message");
+  noise_buffer_set_input(mbuf, message, mbuf.size);
+  check(noise_handshakestate_read_message(responder, &mbuf, nullptr), "noise_handshakestate_read_message");
+  // The ticket id is the payload of the last handshake message
+  NoiseBuffer payload;
+  noise_buffer_set_input(payload, server_ticket_id, sizeof(server_ticket_id));
+  noise_buffer_set_output(mbuf, message, sizeof(message));
+  check(noise_handshakestate_write_message(responder, &mbuf, &payload), "noise_handshakestate_write_message");
+  noise_buffer_set_input(mbuf, message, mbuf.size);
+  noise_buffer_set_output(payload, ticket_id, 16);
+  check(noise_handshakestate_read_message(initiator, &mbuf, &payload), "noise_handshakestate_read_message");
+  if (payload.size != 16 || memcmp(ticket_id, server_ticket_id, 16) != 0) {
+    fprintf(stderr, "Client received a wrong ticket id\n");
+    exit(1);
+  }
+
+  // secret = HKDF(PSK, handshake hash), like APINoiseFrameHelper::check_handshake_finished_()
+  for (auto side : {std::make_pair(initiator, client_secret), std::make_pair(responder, server_secret)}) {
+    uint8_t handshake_hash[32];
+    uint8_t unused[32];
+    check(noise_handshakestate_get_handshake_hash(side.first, handshake_hash, sizeof(handshake_hash)),
+          "noise_handshakestate_get_handshake_hash");
+    NoiseHashState *hash;
+    check(noise_hashstate_new_by_id(&hash, NOISE_HASH_SHA256), "noise_hashstate_new_by_id");
+    noise_hashstate_hkdf(hash, PSK, sizeof(PSK), handshake_hash, sizeof(handshake_hash), side.second, 32, unused,
+                         sizeof(unused));
+    noise_hashstate_free(hash);
+  }
+  noise_handshakestate_free(initiator);
+  noise_handshakestate_free(responder);
+}
+
+/// Derive the ciphers of a resumed session, like APINoiseFrameHelper::resume_session_(). A client swaps send and recv.
+static void resume(const uint8_t *secret, const uint8_t *nonces, NoiseCipherState **send, NoiseCipherState **recv) {
+  uint8_t client_key[32];
+  uint8_t server_key[32];
+  NoiseHashState *hash;
+  check(noise_hashstate_new_by_id(&hash, NOISE_HASH_SHA256), "noise_hashstate_new_by_id");
+  noise_hashstate_hkdf(hash, secret, 32, nonces, 32, client_key, sizeof(client_key), server_key, sizeof(server_key));
+  noise_hashstate_free(hash);
+  check(noise_cipherstate_new_by_id(recv, NOISE_CIPHER_CHACHAPOLY), "noise_cipherstate_new_by_id");
+  check(noise_cipherstate_new_by_id(send, NOISE_CIPHER_CHACHAPOLY), "noise_cipherstate_new_by_id");
+  check(noise_cipherstate_init_key(*recv, client_key, sizeof(client_key)), "noise_cipherstate_init_key");
+  check(noise_cipherstate_init_key(*send, server_key, sizeof(server_key)), "noise_cipherstate_init_key");
+}
+
+static void encrypt_frame(NoiseCipherState *cipher, uint8_t *frame, const uint8_t *payload, size_t payload_len,
+                          size_t frame_len) {
+  frame[0] = 0x01;
+  frame[3] = 0;
+  frame[4] = 25;
+  frame[5] = (uint8_t) (payload_len >> 8);
+  frame[6] = (uint8_t) payload_len;
+  memcpy(&frame[7], payload, payload_len);
+  NoiseBuffer mbuf;
+  noise_buffer_set_inout(mbuf, &frame[3], 4 + payload_len, frame_len - 3);
+  check(noise_cipherstate_encrypt(cipher, &mbuf), "noise_cipherstate_encrypt");
+  frame[1] = (uint8_t) (mbuf.size >> 8);
+  frame[2] = (uint8_t) mbuf.size;
+}
+
+/// Decrypt a frame of encrypt_frame() in place, returns whether it holds type 25 and the payload.
+static bool decrypt_frame(NoiseCipherState *cipher, uint8_t *frame, const uint8_t *payload, size_t payload_len) {
+  if (frame[0] != 0x01)
+    return false;
+  NoiseBuffer mbuf;
+  noise_buffer_set_input(mbuf, &frame[3], (((size_t) frame[1]) << 8) | frame[2]);
+  if (noise_cipherstate_decrypt(cipher, &mbuf) != NOISE_ERROR_NONE || mbuf.size != 4 + payload_len)
+    return false;
+  const size_t data_len = (((size_t) frame[5]) << 8) | frame[6];
+  return frame[3] == 0 && frame[4] == 25 && data_len == payload_len && memcmp(&frame[7], payload, payload_len) == 0;
+}
+
+/// Resume a session from a ticket and send a frame from the client to the server and back through its ciphers.
+static bool resumed_session_round_trip() {
+  uint8_t ticket_id[16];
+  uint8_t client_secret[32];
+  uint8_t server_secret[32];
+  issue_ticket(ticket_id, client_secret, server_secret);
+
+  // client hello 0x02 carries the client nonce, server hello 0x02 the server nonce
+  uint8_t nonces[32];
+  for (auto &b : nonces)
+    b = (uint8_t) rand();  // NOLINT(cert-msc30-c,cert-msc50-cpp)
+  NoiseCipherState *client_send, *client_recv, *server_send, *server_recv;
+  resume(client_secret, nonces, &client_recv, &client_send);
+  resume(server_secret, nonces, &server_send, &server_recv);
+
+  const uint8_t request[] = "subscribe_states";
+  const uint8_t response[] = "a state response that is a bit longer than the request";
+  uint8_t frame[128];
+  encrypt_frame(client_send, frame, request, sizeof(request), sizeof(frame));
+  bool ok = decrypt_frame(server_recv, frame, request, sizeof(request));
+  encrypt_frame(server_send, frame, response, sizeof(response), sizeof(frame));
+  ok = ok && decrypt_frame(client_recv, frame, response, sizeof(response));
+  // A second frame in the same direction uses the next nonce on both sides
+  encrypt_frame(client_send, frame, request, sizeof(request), sizeof(frame));
+  ok = ok && decrypt_frame(server_recv, frame, request, sizeof(request));
+
+  // A client with a different secret, e.g. from a ticket of another session, must not get through
+  client_secret[0] ^= 1;
+  noise_cipherstate_free(client_send);
+  noise_cipherstate_free(client_recv);
+  resume(client_secret, nonces, &client_recv, &client_send);
+  encrypt_frame(client_send, frame, request, sizeof(request), sizeof(frame));
+  ok = ok && !decrypt_frame(server_recv, frame, request, sizeof(request));
+
+  noise_cipherstate_free(client_send);
+  noise_cipherstate_free(client_recv);
+  noise_cipherstate_free(server_send);
+  noise_cipherstate_free(server_recv);
+  return ok;
+}
+
+int main() {
+  check(noise_init(), "noise_init");
+
+  if (!resumed_session_round_trip()) {
+    fprintf(stderr, "A frame sent through a resumed session did not decrypt to what was sent\n");
+    return 1;
+  }
+  printf("%-32s %10s\n", "resumed session round trip", "OK");
+
+  const int handshakes = 2000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < handshakes; i++) {
+    NoiseCipherState *send, *recv;
+    handshake(&send, &recv);
+    noise_cipherstate_free(send);
+    noise_cipherstate_free(recv);
+  }
+  double elapsed = seconds_since(start);
+  printf("%-32s %10.0f /s\n", "full handshake", handshakes / elapsed);
+
+  const int resumptions = 200000;
+  uint8_t secret[32] = {1};
+  uint8_t nonces[32] = {2};
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < resumptions; i++) {
+    NoiseCipherState *send, *recv;
+    nonces[0] = (uint8_t) i;
+    resume(secret, nonces, &send, &recv);
+    noise_cipherstate_free(send);
+    noise_cipherstate_free(recv);
+  }
+  elapsed = seconds_since(start);
+  printf("%-32s %10.0f /s\n", "resumed session", resumptions / elapsed);
+
+  NoiseCipherState *send, *recv;
+  handshake(&send, &recv);
+  for (size_t payload_len : {32, 256, 1024}) {
+    std::vector<uint8_t> payload(payload_len, 0x55);
+    const size_t frame_len = 3 + 4 + payload_len + noise_cipherstate_get_mac_length(send);
+    const size_t packets = (64u << 20) / payload_len;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < packets; i++) {
+      auto frame = std::unique_ptr<uint8_t[]>{new uint8_t[frame_len]};
+      encrypt_frame(send, frame.get(), payload.data(), payload_len, frame_len);
+    }
+    elapsed = seconds_since(start);
+    printf("%4zu byte packets, new frame    %8.1f MB/s\n", payload_len, packets * payload_len / elapsed / 1e6);
+
+    std::vector<uint8_t> buf;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < packets; i++) {
+      buf.resize(frame_len);
+      encrypt_frame(send, buf.data(), payload.data(), payload_len, frame_len);
+    }
+    elapsed = seconds_since(start);
+    printf("%4zu byte packets, in place     %8.1f MB/s\n", payload_len, packets * payload_len / elapsed / 1e6);
+  }
+  noise_cipherstate_free(send);
+  noise_cipherstate_free(recv);
+  return 0;
+}
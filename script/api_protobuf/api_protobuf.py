@@ -64,6 +64,17 @@ def camel_to_snake(name):
     return re.sub("([a-z0-9])([A-Z])", r"\1_\2", s1).lower()
 
 
+SOURCE_BOTH = 0
+SOURCE_SERVER = 1
+SOURCE_CLIENT = 2
+
+
+def get_opt(desc, opt, default=None):
+    if not desc.options.HasExtension(opt):
+        return default
+    return desc.options.Extensions[opt]
+
+
 class TypeInfo:
     def __init__(self, field):
         self._field = field
@@ -182,6 +193,24 @@ class TypeInfo:
 
     encode_func = None
 
+    @property
+    def field_id_size(self):
+        # The wire type bits don't change the size of the tag
+        tag = self.number << 3
+        size = 1
+        while tag > 0x7F:
+            tag >>= 7
+            size += 1
+        return size
+
+    @property
+    def size_content(self):
+        return f"ProtoSize::{self.size_func}(total_size, {self.field_id_size}, this->{self.field_name});"
+
+    @property
+    def size_func(self):
+        return f"add_{self.encode_func[len('encode_'):]}_field"
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -320,6 +349,19 @@ class StringType(TypeInfo):
         return o
 
 
+class StringRefType(StringType):
+    """String or bytes field of a message that is only decoded, pointing into the receive buffer."""
+
+    cpp_type = "StringRef"
+    reference_type = "StringRef &"
+    const_reference_type = "const StringRef &"
+    decode_length = "value.as_string_ref()"
+
+    def dump(self, name):
+        o = f'out.append("\'").append({name}.c_str(), {name}.size()).append("\'");'
+        return o
+
+
 @register_type(11)
 class MessageType(TypeInfo):
     @property
@@ -340,6 +382,10 @@ class MessageType(TypeInfo):
     def encode_func(self):
         return f"encode_message<{self.cpp_type}>"
 
+    @property
+    def size_func(self):
+        return f"add_message_field<{self.cpp_type}>"
+
     @property
     def decode_length(self):
         return f"value.as_message<{self.cpp_type}>()"
@@ -392,6 +438,10 @@ class EnumType(TypeInfo):
     def encode_func(self):
         return f"encode_enum<{self.cpp_type}>"
 
+    @property
+    def size_func(self):
+        return f"add_enum_field<{self.cpp_type}>"
+
     def dump(self, name):
         o = f"out.append(proto_enum_to_string<{self.cpp_type}>({name}));"
         return o
@@ -479,8 +529,22 @@ class RepeatedTypeInfo(TypeInfo):
         }}"""
         )
 
+    @property
+    def packed(self):
+        # Only fields with fixed 32 bit values are supported, proto3 packs the others by default too
+        # but they are sent unpacked for compatibility with existing clients
+        return self._field.options.packed and isinstance(self._ti, (Fixed32Type, FloatType))
+
     @property
     def decode_length_content(self) -> str:
+        if self.packed:
+            return dedent(
+                f"""\
+            case {self.number}: {{
+              value.as_packed_32bit(this->{self.field_name});
+              return true;
+            }}"""
+            )
         content = self._ti.decode_length
         if content is None:
             return None
@@ -525,11 +589,22 @@ class RepeatedTypeInfo(TypeInfo):
 
     @property
     def encode_content(self):
+        if self.packed:
+            return f"buffer.encode_packed_32bit({self.number}, this->{self.field_name});"
         o = f"for (auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
         o += f"  buffer.{self._ti.encode_func}({self.number}, it, true);\n"
         o += f"}}"
         return o
 
+    @property
+    def size_content(self):
+        if self.packed:
+            return f"ProtoSize::add_packed_32bit_field(total_size, {self.field_id_size}, this->{self.field_name});"
+        o = f"for (auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  ProtoSize::{self._ti.size_func}(total_size, {self.field_id_size}, it, true);\n"
+        o += f"}}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -562,7 +637,34 @@ def build_enum_type(desc):
     return out, cpp
 
 
-def build_message_type(desc):
+def get_decode_only_messages(messages):
+    """Names of the messages the server only decodes: those sent by clients, and the
+    nested messages used by them alone.
+
+    Their (non-repeated) string fields are decoded as StringRef into the receive
+    buffer instead of being copied, so they are only valid until the handler returns.
+    """
+    decode_only = {
+        m.name for m in messages if get_opt(m, pb.source, 0) == SOURCE_CLIENT
+    }
+    users = {}
+    for m in messages:
+        for field in m.field:
+            if field.type == 11:
+                users.setdefault(field.type_name[1:], set()).add(m.name)
+    changed = True
+    while changed:
+        changed = False
+        for m in messages:
+            if m.name in decode_only or get_opt(m, pb.id) is not None:
+                continue
+            if m.name in users and users[m.name] <= decode_only:
+                decode_only.add(m.name)
+                changed = True
+    return decode_only
+
+
+def build_message_type(desc, decode_only=False):
     public_content = []
     protected_content = []
     decode_varint = []
@@ -570,16 +672,20 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    size = []
     dump = []
 
     for field in desc.field:
         if field.label == 3:
             ti = RepeatedTypeInfo(field)
+        elif decode_only and field.type in (9, 12):
+            ti = StringRefType(field)
         else:
             ti = TYPE_INFO[field.type](field)
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        size.append(ti.size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -646,6 +752,18 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if size:
+        if len(size) == 1 and len(size[0]) + len(o) + 3 < 120:
+            o += f" {size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120:
@@ -716,9 +834,10 @@ for enum in file.enum_type:
 content += "\n}  // namespace enums\n\n"
 
 mt = file.message_type
+decode_only_messages = get_decode_only_messages(mt)
 
 for m in mt:
-    s, c = build_message_type(m)
+    s, c = build_message_type(m, m.name in decode_only_messages)
     content += s
     cpp += c
 
@@ -739,10 +858,6 @@ with open(root / "api_pb2.h", "w") as f:
 with open(root / "api_pb2.cpp", "w") as f:
     f.write(cpp)
 
-SOURCE_BOTH = 0
-SOURCE_SERVER = 1
-SOURCE_CLIENT = 2
-
 RECEIVE_CASES = {}
 
 class_name = "APIServerConnectionBase"
@@ -750,12 +865,6 @@ class_name = "APIServerConnectionBase"
 ifdefs = {}
 
 
-def get_opt(desc, opt, default=None):
-    if not desc.options.HasExtension(opt):
-        return default
-    return desc.options.Extensions[opt]
-
-
 def build_service_message_type(mt):
     snake = camel_to_snake(mt.name)
     id_ = get_opt(mt, pb.id)
@@ -791,20 +900,7 @@ def build_service_message_type(mt):
         # Generate receive
         func = f"on_{snake}"
         hout += f"virtual void {func}(const {mt.name} &value){{}};\n"
-        case = ""
-        if ifdef is not None:
-            case += f"#ifdef {ifdef}\n"
-        case += f"{mt.name} msg;\n"
-        case += f"msg.decode(msg_data, msg_size);\n"
-        if log:
-            case += f"#ifdef HAS_PROTO_MESSAGE_DUMP\n"
-            case += f'ESP_LOGVV(TAG, "{func}: %s", msg.dump().c_str());\n'
-            case += f"#endif\n"
-        case += f"this->{func}(msg);\n"
-        if ifdef is not None:
-            case += f"#endif\n"
-        case += "break;"
-        RECEIVE_CASES[id_] = case
+        RECEIVE_CASES[id_] = (mt.name, func, ifdef)
 
     if ifdef is not None:
         hout += f"#endif\n"
@@ -830,6 +926,9 @@ cpp += """\
 #include "api_pb2_service.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace api {
 
@@ -848,26 +947,75 @@ for mt in file.message_type:
     hpp += indent(hout) + "\n"
     cpp += cout
 
+serv = file.service[0]
+
+# Connection state the service methods need before their request is handled
+requirements = {}
+for m in serv.method:
+    flags = []
+    if get_opt(m, pb.needs_setup_connection, True):
+        flags.append("NEEDS_SETUP_CONNECTION")
+    if get_opt(m, pb.needs_authentication, True):
+        flags.append("NEEDS_AUTHENTICATION")
+    requirements[m.input_type[1:]] = " | ".join(flags) or "0"
+
 cases = list(RECEIVE_CASES.items())
 cases.sort()
 hpp += " protected:\n"
 hpp += f"  bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;\n"
-out = f"bool {class_name}::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {{\n"
-out += f"  switch (msg_type) {{\n"
-for i, case in cases:
-    c = f"case {i}: {{\n"
-    c += indent(case) + "\n"
-    c += f"}}"
-    out += indent(c, "    ") + "\n"
-out += "    default:\n"
-out += "      return false;\n"
+out = "static const uint8_t NEEDS_SETUP_CONNECTION = 1 << 0;\n"
+out += "static const uint8_t NEEDS_AUTHENTICATION = 1 << 1;\n\n"
+out += "struct MessageHandler {\n"
+out += "  uint16_t msg_type;\n"
+out += "  uint8_t requirements;\n"
+out += f"  void (*handle)({class_name} *conn, uint8_t *msg_data, uint32_t msg_size);\n"
+out += "};\n\n"
+out += f"template<class T, void ({class_name}::*Handler)(const T &)>\n"
+out += f"static void handle_message({class_name} *conn, uint8_t *msg_data, uint32_t msg_size) {{\n"
+out += "  T msg;\n"
+out += "  msg.decode(msg_data, msg_size);\n"
+out += "#ifdef HAS_PROTO_MESSAGE_DUMP\n"
+out += '  ESP_LOGVV(TAG, "Received %s", msg.dump().c_str());\n'
+out += "#endif\n"
+out += "  (conn->*Handler)(msg);\n"
+out += "}\n\n"
+out += "// Sorted by message type\n"
+out += "static constexpr MessageHandler MESSAGE_HANDLERS[] = {\n"
+for i, (name, func, ifdef) in cases:
+    if ifdef is not None:
+        out += f"#ifdef {ifdef}\n"
+    req = requirements.get(name, "0")
+    entry = f"    {{{i}, {req}, handle_message<{name}, &{class_name}::{func}>}},"
+    if len(entry) > 120:
+        entry = f"    {{{i}, {req},\n     handle_message<{name}, &{class_name}::{func}>}},"
+    if len(entry.split("\n")[-1]) > 120:
+        entry = f"    {{{i}, {req},\n     handle_message<{name},\n                    &{class_name}::{func}>}},"
+    out += entry + "\n"
+    if ifdef is not None:
+        out += f"#endif\n"
+out += "};\n\n"
+out += f"bool {class_name}::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {{\n"
+out += "  const MessageHandler *end = MESSAGE_HANDLERS + sizeof(MESSAGE_HANDLERS) / sizeof(MESSAGE_HANDLERS[0]);\n"
+out += "  const MessageHandler *handler = std::lower_bound(\n"
+out += "      MESSAGE_HANDLERS, end, msg_type, [](const MessageHandler &h, uint32_t type) { return h.msg_type < type; });\n"
+out += "  if (handler == end || handler->msg_type != msg_type) {\n"
+out += '    ESP_LOGV(TAG, "Ignoring unknown message type %" PRIu32, msg_type);\n'
+out += "    return false;\n"
+out += "  }\n"
+out += "  if ((handler->requirements & NEEDS_SETUP_CONNECTION) && !this->is_connection_setup()) {\n"
+out += "    this->on_no_setup_connection();\n"
+out += "    return true;\n"
 out += "  }\n"
+out += "  if ((handler->requirements & NEEDS_AUTHENTICATION) && !this->is_authenticated()) {\n"
+out += "    this->on_unauthenticated_access();\n"
+out += "    return true;\n"
+out += "  }\n"
+out += "  handler->handle(this, msg_data, msg_size);\n"
 out += "  return true;\n"
 out += "}\n"
 cpp += out
 hpp += "};\n"
 
-serv = file.service[0]
 class_name = "APIServerConnection"
 hpp += "\n"
 hpp += f"class {class_name} : public {class_name}Base {{\n"
@@ -883,8 +1031,6 @@ for m in serv.method:
     is_void = ret == "void"
     snake = camel_to_snake(inp)
     on_func = f"on_{snake}"
-    needs_conn = get_opt(m, pb.needs_setup_connection, True)
-    needs_auth = get_opt(m, pb.needs_authentication, True)
 
     ifdef = ifdefs.get(inp, None)
 
@@ -895,28 +1041,21 @@ for m in serv.method:
 
     hpp_protected += f"  void {on_func}(const {inp} &msg) override;\n"
     hpp += f"  virtual {ret} {func}(const {inp} &msg) = 0;\n"
-    cpp += f"void {class_name}::{on_func}(const {inp} &msg) {{\n"
-    body = ""
-    if needs_conn:
-        body += "if (!this->is_connection_setup()) {\n"
-        body += "  this->on_no_setup_connection();\n"
-        body += "  return;\n"
-        body += "}\n"
-    if needs_auth:
-        body += "if (!this->is_authenticated()) {\n"
-        body += "  this->on_unauthenticated_access();\n"
-        body += "  return;\n"
-        body += "}\n"
-
-    if is_void:
-        body += f"this->{func}(msg);\n"
+    signature = f"void {class_name}::{on_func}(const {inp} &msg)"
+    if is_void and len(f"{signature} {{ this->{func}(msg); }}") <= 120:
+        cpp += f"{signature} {{ this->{func}(msg); }}\n"
     else:
-        body += f"{ret} ret = this->{func}(msg);\n"
-        ret_snake = camel_to_snake(ret)
-        body += f"if (!this->send_{ret_snake}(ret)) {{\n"
-        body += f"  this->on_fatal_error();\n"
-        body += "}\n"
-    cpp += indent(body) + "\n" + "}\n"
+        cpp += f"{signature} {{\n"
+        body = ""
+        if is_void:
+            body += f"this->{func}(msg);\n"
+        else:
+            body += f"{ret} ret = this->{func}(msg);\n"
+            ret_snake = camel_to_snake(ret)
+            body += f"if (!this->send_{ret_snake}(ret)) {{\n"
+            body += f"  this->on_fatal_error();\n"
+            body += "}\n"
+        cpp += indent(body) + "\n" + "}\n"
 
     if ifdef is not None:
         hpp += f"#endif\n"
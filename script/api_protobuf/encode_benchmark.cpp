@@ -0,0 +1,119 @@
+// Microbenchmark for encoding native API messages on the host.
+//
+// Also compares sending sensor updates as one SensorStateResponse each with sending them in a single
+// BatchSensorStateResponse, counting the bytes of the plaintext frames that go over the wire.
+//
+// Build and run from the repository root:
+//     g++ -std=gnu++17 -O2 -I. -DUSE_HOST -DUSE_API -DUSE_BLUETOOTH_PROXY -DUSE_CLIMATE -DUSE_SENSOR \
+//         script/api_protobuf/encode_benchmark.cpp esphome/components/api/api_pb2.cpp \
+//         esphome/components/api/proto.cpp -o encode_benchmark && ./encode_benchmark
+
+#include "esphome/components/api/api_pb2.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace esphome::api;
+
+static const int ITERATIONS = 200000;
+static const int SENSOR_COUNT = 32;
+
+/// Size of a plaintext frame: zero byte, varint size and type, then the message.
+static size_t frame_size(size_t msg_size, uint32_t msg_type) {
+  return 1 + ProtoSize::varint(static_cast<uint32_t>(msg_size)) + ProtoSize::varint(msg_type) + msg_size;
+}
+
+template<class C> void run(const char *name, const C &msg) {
+  std::vector<uint8_t> data;
+  size_t size = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++) {
+    // Same steps as ProtoService::send_message_(), with a buffer reused across messages
+    data.clear();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    data.reserve(msg_size);
+    msg.encode(ProtoWriteBuffer(&data));
+    size += data.size();
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  printf("%-36s %4zu bytes %8.1f ns/message\n", name, size / ITERATIONS, elapsed / ITERATIONS);
+}
+
+int main() {
+  ListEntitiesSensorResponse sensor;
+  sensor.object_id = "living_room_temperature";
+  sensor.key = 0x12345678;
+  sensor.name = "Living Room Temperature";
+  sensor.unique_id = "livingroomsensortemperature";
+  sensor.unit_of_measurement = "°C";
+  sensor.accuracy_decimals = 1;
+  sensor.device_class = "temperature";
+  sensor.state_class = enums::STATE_CLASS_MEASUREMENT;
+  run("ListEntitiesSensorResponse", sensor);
+
+  BluetoothLEAdvertisementResponse adv;
+  adv.address = 0xA4C1389F1B2CULL;
+  adv.name = "ATC_9F1B2C";
+  adv.rssi = -72;
+  adv.service_uuids.emplace_back("0000181a-0000-1000-8000-00805f9b34fb");
+  BluetoothServiceData service_data;
+  service_data.uuid = "0000181a-0000-1000-8000-00805f9b34fb";
+  service_data.data = std::string("\xa4\xc1\x38\x9f\x1b\x2c\x00\xd2\x25\x0b\xb8\x5a\x0b", 13);
+  adv.service_data.push_back(service_data);
+  BluetoothServiceData manufacturer_data;
+  manufacturer_data.uuid = "0x004C";
+  manufacturer_data.data = std::string("\x02\x15\xfd\xa5\x06\x93\xa4\xe2\x4f\xb1\xaf\xcf\xc6\xeb", 14);
+  adv.manufacturer_data.push_back(manufacturer_data);
+  run("BluetoothLEAdvertisementResponse", adv);
+
+  ClimateStateResponse climate;
+  climate.key = 0x87654321;
+  climate.mode = enums::CLIMATE_MODE_HEAT;
+  climate.current_temperature = 20.5f;
+  climate.target_temperature = 21.0f;
+  climate.action = enums::CLIMATE_ACTION_HEATING;
+  climate.fan_mode = enums::CLIMATE_FAN_AUTO;
+  climate.preset = enums::CLIMATE_PRESET_COMFORT;
+  run("ClimateStateResponse", climate);
+
+  std::vector<SensorStateResponse> sensor_states(SENSOR_COUNT);
+  BatchSensorStateResponse batch;
+  for (int i = 0; i < SENSOR_COUNT; i++) {
+    sensor_states[i].key = 0x9E3779B9u * (i + 1);
+    sensor_states[i].state = 230.0f + i * 0.1f;
+    batch.keys.push_back(sensor_states[i].key);
+    batch.states.push_back(sensor_states[i].state);
+  }
+
+  std::vector<uint8_t> data;
+  size_t single_bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS / SENSOR_COUNT; i++) {
+    single_bytes = 0;
+    for (auto &msg : sensor_states) {
+      data.clear();
+      msg.encode(ProtoWriteBuffer(&data));
+      single_bytes += frame_size(data.size(), 25);
+    }
+  }
+  auto single_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  size_t batch_bytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS / SENSOR_COUNT; i++) {
+    data.clear();
+    batch.encode(ProtoWriteBuffer(&data));
+    batch_bytes = frame_size(data.size(), 99);
+  }
+  auto batch_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  printf("\n%d sensor updates:\n", SENSOR_COUNT);
+  printf("%-36s %4zu bytes %8.1f ns/update\n", "SensorStateResponse each", single_bytes,
+         single_ns / (ITERATIONS / SENSOR_COUNT * SENSOR_COUNT));
+  printf("%-36s %4zu bytes %8.1f ns/update\n", "BatchSensorStateResponse", batch_bytes,
+         batch_ns / (ITERATIONS / SENSOR_COUNT * SENSOR_COUNT));
+  return 0;
+}
@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Run many instances of a host platform build side by side.
+
+Every instance gets its own instance id, which gives it a distinct MAC address
+(and with that a distinct name when name_add_mac_suffix is enabled), its own
+preferences file and listening ports offset by the instance id (API on
+6053 + id). Use it to put realistic load on API/MQTT servers, or to compare the
+CPU time and memory of the firmware itself across changes.
+
+Example, for a configuration using the host platform named "node":
+    esphome compile node.yaml
+    script/host_harness.py .esphome/build/node/.pioenvs/node/program -n 50 -d 300
+"""
+import argparse
+import os
+from pathlib import Path
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+
+API_PORT = 6053
+
+
+def read_usage(pid):
+    """Return (cpu seconds, resident set size in KiB) of a running process."""
+    with open(f"/proc/{pid}/stat", encoding="utf-8") as stat:
+        # The command name may contain spaces, the fields after it don't
+        fields = stat.read().rsplit(")", 1)[1].split()
+    cpu = (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+    rss = 0
+    with open(f"/proc/{pid}/status", encoding="utf-8") as status:
+        for line in status:
+            if line.startswith("VmRSS:"):
+                rss = int(line.split()[1])
+    return cpu, rss
+
+
+def print_report(instances, elapsed):
+    total_cpu = 0.0
+    total_rss = 0
+    print(f"{'instance':>8} {'api port':>8} {'cpu %':>7} {'rss KiB':>9}  status")
+    for instance_id, proc in instances:
+        status = "running" if proc.poll() is None else f"exited ({proc.returncode})"
+        try:
+            cpu, rss = read_usage(proc.pid)
+        except (FileNotFoundError, ProcessLookupError):
+            cpu, rss = 0.0, 0
+        total_cpu += cpu
+        total_rss += rss
+        print(
+            f"{instance_id:>8} {API_PORT + instance_id:>8} "
+            f"{100 * cpu / elapsed:>7.2f} {rss:>9}  {status}"
+        )
+    print(
+        f"{'total':>8} {'':>8} {100 * total_cpu / elapsed:>7.2f} {total_rss:>9}  "
+        f"({len(instances)} instances, {elapsed:.1f}s)"
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("program", type=Path, help="host program built by esphome")
+    parser.add_argument(
+        "-n", "--count", type=int, default=10, help="number of instances to run"
+    )
+    parser.add_argument(
+        "--first-instance", type=int, default=0, help="instance id of the first one"
+    )
+    parser.add_argument(
+        "-t",
+        "--time-scale",
+        type=float,
+        default=1.0,
+        help="run the clock of every instance this many times faster than real time",
+    )
+    parser.add_argument(
+        "-d",
+        "--duration",
+        type=float,
+        default=0,
+        help="stop after this many seconds, 0 to run until interrupted",
+    )
+    parser.add_argument(
+        "-r",
+        "--report-interval",
+        type=float,
+        default=10,
+        help="seconds between resource usage reports",
+    )
+    parser.add_argument(
+        "-w",
+        "--work-dir",
+        type=Path,
+        help="directory for preferences and logs (default: a temporary directory)",
+    )
+    args = parser.parse_args()
+
+    work_dir = args.work_dir or Path(tempfile.mkdtemp(prefix="esphome-host-"))
+    work_dir.mkdir(parents=True, exist_ok=True)
+    print(f"Writing preferences and logs to {work_dir}")
+
+    instances = []
+    for instance_id in range(args.first_instance, args.first_instance + args.count):
+        with open(work_dir / f"instance-{instance_id}.log", "wb") as log:
+            proc = subprocess.Popen(  # pylint: disable=consider-using-with
+                [
+                    str(args.program),
+                    "--instance",
+                    str(instance_id),
+                    "--time-scale",
+                    str(args.time_scale),
+                    "--preferences",
+                    str(work_dir / f"instance-{instance_id}.prefs"),
+                ],
+                stdout=log,
+                stderr=subprocess.STDOUT,
+            )
+        instances.append((instance_id, proc))
+
+    started = time.monotonic()
+    next_report = started + args.report_interval
+    try:
+        while args.duration == 0 or time.monotonic() - started < args.duration:
+            time.sleep(min(1.0, args.report_interval))
+            if time.monotonic() >= next_report:
+                print_report(instances, time.monotonic() - started)
+                next_report += args.report_interval
+    except KeyboardInterrupt:
+        pass
+
+    print_report(instances, time.monotonic() - started)
+    # SIGTERM shuts the instances down cleanly, which also writes their preferences
+    for _, proc in instances:
+        if proc.poll() is None:
+            proc.send_signal(signal.SIGTERM)
+    for _, proc in instances:
+        try:
+            proc.wait(timeout=10)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
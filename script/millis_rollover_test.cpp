@@ -0,0 +1,129 @@
+// Test of the scheduler across the 32-bit millis() wrap on the host.
+//
+// Fast-forwards the host's virtual clock to a few seconds before millis() wraps around after 49.7 days, runs it 50
+// times faster than real time and checks that timeouts and intervals set before, across and after the wrap run in
+// order and on time, while millis() wraps and millis_64() keeps counting.
+//
+// Built and run by script/host_test, linked against the scheduler, helpers and the host clock.
+
+#include "esphome/core/scheduler.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/components/host/core.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+
+namespace esphome {
+
+// The parts of Component and the host platform the scheduler and helpers use
+bool Component::is_failed() { return false; }
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component) : component_(component) {}
+WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {}
+namespace host {
+static const HostOptions OPTIONS;
+const HostOptions &get_options() { return OPTIONS; }
+}  // namespace host
+
+}  // namespace esphome
+
+using namespace esphome;
+
+static const uint64_t WRAP = 1ULL << 32;
+/// How long before the wrap the test starts, and how long it runs.
+static const uint64_t LEAD_MS = 3000;
+static const uint64_t DURATION_MS = 10000;
+static const double TIME_SCALE = 50.0;
+/// How late a callback may run, the scheduler is only called every few real milliseconds.
+static const uint64_t SLACK_MS = 250;
+
+static int failures = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void check(bool ok, const char *what, uint64_t value, uint64_t expected) {
+  printf("%-40s %12" PRIu64 " (expected %12" PRIu64 ") %s\n", what, value, expected, ok ? "OK" : "FAIL");
+  if (!ok)
+    failures++;
+}
+/// Whether a callback ran at `at`, not before `deadline` and at most SLACK_MS after.
+static bool on_time(uint64_t at, uint64_t deadline) { return at >= deadline && at <= deadline + SLACK_MS; }
+
+int main() {
+  // Jump to LEAD_MS before the next wrap of millis(), then let the clock run faster
+  host::advance_clock((millis_64() / WRAP + 1) * WRAP - LEAD_MS - millis_64());
+  host::set_time_scale(TIME_SCALE);
+
+  Scheduler scheduler;
+  const uint64_t start = millis_64();
+  const uint64_t wrap_at = (start / WRAP + 1) * WRAP;
+  printf("Starting at millis() %" PRIu32 ", %" PRIu64 " ms before it wraps\n", millis(), wrap_at - start);
+
+  uint64_t before_at = 0, across_at = 0, after_at = 0, after_set = 0;
+  uint32_t millis_mismatches = 0;
+  auto check_millis = [&millis_mismatches]() {
+    // millis() is the lower half of millis_64(), the clock may tick between reading them
+    uint32_t a = millis();
+    uint64_t b = millis_64();
+    if (uint32_t(b) - a > 1)
+      millis_mismatches++;
+  };
+
+  std::vector<uint64_t> interval_runs;
+  scheduler.set_timeout(nullptr, "before", 1000, [&]() {
+    before_at = millis_64();
+    check_millis();
+  });
+  // Its deadline is past the wrap, a 32-bit comparison would run it right away or never
+  scheduler.set_timeout(nullptr, "across", LEAD_MS + 2000, [&]() {
+    across_at = millis_64();
+    check_millis();
+    after_set = across_at;
+    scheduler.set_timeout(nullptr, "after", 1000, [&]() {
+      after_at = millis_64();
+      check_millis();
+    });
+  });
+  scheduler.set_interval(nullptr, "interval", 1000, [&]() {
+    interval_runs.push_back(millis_64());
+    check_millis();
+  });
+  // Cancelled before it runs, across the wrap
+  bool cancelled_ran = false;
+  scheduler.set_timeout(nullptr, "cancelled", LEAD_MS + 4000, [&cancelled_ran]() { cancelled_ran = true; });
+  scheduler.set_timeout(nullptr, "cancel", LEAD_MS + 1000,
+                        [&scheduler]() { scheduler.cancel_timeout(nullptr, "cancelled"); });
+
+  optional<uint32_t> wrapped_millis;
+  while (millis_64() < start + DURATION_MS) {
+    scheduler.call();
+    if (millis_64() >= wrap_at && !wrapped_millis.has_value())
+      wrapped_millis = millis();
+    auto next = scheduler.next_schedule_in();
+    delay(std::min<uint32_t>(next.value_or(100), 100));
+  }
+
+  check(wrapped_millis.has_value() && *wrapped_millis < SLACK_MS, "millis() after the wrap", wrapped_millis.value_or(0),
+        0);
+  check(millis_mismatches == 0, "millis() != lower half of millis_64()", millis_mismatches, 0);
+  check(on_time(before_at, start + 1000), "timeout before the wrap ran at", before_at - start, 1000);
+  check(on_time(across_at, start + LEAD_MS + 2000), "timeout across the wrap ran at", across_at - start,
+        LEAD_MS + 2000);
+  check(after_set >= wrap_at && on_time(after_at, after_set + 1000), "timeout after the wrap ran at",
+        after_at - start, after_set + 1000 - start);
+  check(!cancelled_ran, "cancelled timeout ran", cancelled_ran, 0);
+
+  // The interval first runs right away, then every 1000 ms shifted by a random offset of up to 500 ms
+  check(interval_runs.size() >= DURATION_MS / 1000 && interval_runs.size() <= DURATION_MS / 1000 + 1,
+        "interval runs", interval_runs.size(), DURATION_MS / 1000);
+  uint64_t shortest_gap = UINT64_MAX, longest_gap = 0;
+  for (size_t i = 2; i < interval_runs.size(); i++) {
+    shortest_gap = std::min(shortest_gap, interval_runs[i] - interval_runs[i - 1]);
+    longest_gap = std::max(longest_gap, interval_runs[i] - interval_runs[i - 1]);
+  }
+  check(shortest_gap + SLACK_MS >= 1000, "shortest interval gap", shortest_gap, 1000);
+  check(longest_gap <= 1000 + SLACK_MS, "longest interval gap", longest_gap, 1000);
+
+  printf(failures == 0 ? "All checks passed\n" : "%d checks failed\n", failures);
+  return failures == 0 ? 0 : 1;
+}
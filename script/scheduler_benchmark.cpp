@@ -0,0 +1,164 @@
+// Benchmark of the scheduler item pool on the host.
+//
+// Runs the same set_timeout()/cancel_timeout() churn through the scheduler with and without `scheduler_pool_size`
+// and reports the time and heap allocations per operation. The pool is a compile time option, so build the benchmark
+// once per variant and compare the output.
+//
+// Built and run by script/host_test, linked against the scheduler and helpers, once with a pool and once without.
+
+#include "esphome/core/scheduler.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/components/host/core.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+static size_t allocations = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void *operator new(size_t size) {
+  allocations++;
+  void *ptr = malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }                   // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void *ptr, size_t /*size*/) noexcept { free(ptr); }  // NOLINT(cppcoreguidelines-no-malloc)
+
+namespace esphome {
+
+// The scheduler only needs a clock, and the parts of Component it calls for items of a component. The clock only
+// advances between loop iterations, so that timing noise doesn't change which items run.
+static uint64_t now_ms = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+uint64_t millis_64() { return now_ms; }
+uint32_t millis() { return now_ms; }
+uint32_t micros() { return now_ms * 1000; }
+void delay(uint32_t /*ms*/) {}
+namespace host {
+static const HostOptions OPTIONS;
+const HostOptions &get_options() { return OPTIONS; }
+}  // namespace host
+bool Component::is_failed() { return false; }
+WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component) : component_(component) {}
+WarnIfComponentBlockingGuard::~WarnIfComponentBlockingGuard() {}
+
+}  // namespace esphome
+
+using namespace esphome;
+
+static const size_t COMPONENT_COUNT = 16;
+static const size_t ROUNDS = 20000;
+static const size_t REPEATS = 5;
+
+struct Result {
+  double ns_per_op;
+  double allocations_per_op;
+};
+
+/// Run `round` ROUNDS times with the main loop calling the scheduler in between, per operation `round` reports. The
+/// time is the fastest of REPEATS runs.
+template<typename F> static Result measure(Scheduler &scheduler, F &&round) {
+  double best_ns = 0;
+  size_t total_ops = 0;
+  size_t allocations_before = allocations;
+  for (size_t repeat = 0; repeat < REPEATS; repeat++) {
+    size_t ops = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ROUNDS; i++) {
+      ops += round();
+      now_ms++;
+      scheduler.call();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+    if (repeat == 0 || ns < best_ns)
+      best_ns = ns;
+    total_ops += ops;
+  }
+  return Result{best_ns, double(allocations - allocations_before) / total_ops};
+}
+
+int main() {
+  // Items are keyed by their component, its methods aren't called on the items used here
+  std::vector<Component *> components;
+  for (size_t i = 0; i < COMPONENT_COUNT; i++)
+    components.push_back(reinterpret_cast<Component *>(0x1000 + i * 64));  // NOLINT
+  std::vector<std::string> names;
+  for (size_t i = 0; i < COMPONENT_COUNT; i++)
+    names.push_back("timeout_" + std::to_string(i));
+  uint32_t counter = 0;
+
+#ifdef USE_SCHEDULER_POOL
+  printf("Scheduler with a pool of %u items\n", ESPHOME_SCHEDULER_POOL_SIZE);
+#else
+  printf("Scheduler without pool\n");
+#endif
+
+  // Every component restarts a named timeout that never expires, e.g. a debounce, replacing its pending one
+  {
+    Scheduler scheduler;
+    Result r = measure(scheduler, [&]() {
+      for (size_t c = 0; c < COMPONENT_COUNT; c++)
+        scheduler.set_timeout(nullptr, names[c], 1000, [&counter]() { counter++; });
+      return COMPONENT_COUNT;
+    });
+    printf("  restart named timeout:    %7.1f ns/op %5.2f allocations/op\n", r.ns_per_op, r.allocations_per_op);
+  }
+  // The same with timeouts identified by a numeric id, no name strings involved
+  {
+    Scheduler scheduler;
+    Result r = measure(scheduler, [&]() {
+      for (size_t c = 0; c < COMPONENT_COUNT; c++)
+        scheduler.set_timeout(components[c], 1234, 1000, [&counter]() { counter++; });
+      return COMPONENT_COUNT;
+    });
+    printf("  restart timeout by id:    %7.1f ns/op %5.2f allocations/op\n", r.ns_per_op, r.allocations_per_op);
+  }
+  // Set a named timeout and cancel it again before it runs, e.g. waiting for a reply that arrives in time
+  {
+    Scheduler scheduler;
+    Result r = measure(scheduler, [&]() {
+      for (size_t c = 0; c < COMPONENT_COUNT; c++)
+        scheduler.set_timeout(nullptr, names[c], 1000, [&counter]() { counter++; });
+      for (size_t c = 0; c < COMPONENT_COUNT; c++)
+        scheduler.cancel_timeout(nullptr, names[c]);
+      return 2 * COMPONENT_COUNT;
+    });
+    printf("  set and cancel timeout:   %7.1f ns/op %5.2f allocations/op\n", r.ns_per_op, r.allocations_per_op);
+  }
+  // Cancel a named timeout among many pending ones, which the pool's index finds without scanning them all
+  {
+    Scheduler scheduler;
+    std::vector<std::string> pending;
+    for (size_t i = 0; i < 200; i++) {
+      pending.push_back("pending_" + std::to_string(i));
+      scheduler.set_timeout(nullptr, pending.back(), 1000000, []() {});
+    }
+    Result r = measure(scheduler, [&]() {
+      scheduler.set_timeout(nullptr, names[0], 1000, [&counter]() { counter++; });
+      scheduler.cancel_timeout(nullptr, names[0]);
+      return 2;
+    });
+    printf("  ... with 200 pending:     %7.1f ns/op %5.2f allocations/op\n", r.ns_per_op, r.allocations_per_op);
+  }
+  // Anonymous timeouts that expire on the next loop iteration, e.g. defer()
+  {
+    Scheduler scheduler;
+    Result r = measure(scheduler, [&]() {
+      for (size_t c = 0; c < COMPONENT_COUNT; c++)
+        scheduler.set_timeout(nullptr, "", 0, [&counter]() { counter++; });
+      return COMPONENT_COUNT;
+    });
+    printf("  defer and run:            %7.1f ns/op %5.2f allocations/op\n", r.ns_per_op, r.allocations_per_op);
+  }
+
+  if (counter != REPEATS * ROUNDS * COMPONENT_COUNT) {
+    printf("Ran %u deferred callbacks, expected %zu\n", counter, REPEATS * ROUNDS * COMPONENT_COUNT);
+    return 1;
+  }
+  return 0;
+}
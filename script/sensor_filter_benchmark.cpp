@@ -0,0 +1,208 @@
+// Benchmark of the sliding window sensor filters on the host.
+//
+// Feeds the same values through the window structures MedianFilter, QuantileFilter, MinFilter, MaxFilter and
+// SlidingWindowMovingAverageFilter use, and through the previous implementation of these filters (a std::deque that
+// is copied and sorted or scanned for every result), checks both give the same results and compares their speed.
+// Also compares the quantiles TimeWindowFilter interpolates from the histograms of its buckets with the exact ones.
+//
+// Built and run by script/host_test, exits with 1 if the results differ.
+
+#include "esphome/components/sensor/sliding_window.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+using namespace esphome::sensor;
+
+static const size_t VALUE_COUNT = 200000;
+
+/// The previous implementation: a deque of the window, copied without NaN values and sorted for every result.
+class DequeWindow {
+ public:
+  explicit DequeWindow(size_t window_size) : window_size_(window_size) {}
+  void push(float value) {
+    while (this->queue_.size() >= this->window_size_)
+      this->queue_.pop_front();
+    this->queue_.push_back(value);
+  }
+  std::vector<float> sorted() const {
+    std::vector<float> sorted;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        sorted.push_back(v);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  }
+  float min() const {
+    float min = NAN;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        min = std::isnan(min) ? v : std::min(min, v);
+    }
+    return min;
+  }
+  float max() const {
+    float max = NAN;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v))
+        max = std::isnan(max) ? v : std::max(max, v);
+    }
+    return max;
+  }
+  float average() const {
+    float sum = 0;
+    size_t valid_count = 0;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v)) {
+        sum += v;
+        valid_count++;
+      }
+    }
+    return valid_count ? sum / valid_count : NAN;
+  }
+
+ protected:
+  size_t window_size_;
+  std::deque<float> queue_;
+};
+
+static float median(const std::vector<float> &sorted) {
+  const size_t size = sorted.size();
+  if (size == 0)
+    return NAN;
+  if (size % 2)
+    return sorted[size / 2];
+  return (sorted[size / 2] + sorted[(size / 2) - 1]) / 2.0f;
+}
+
+static bool same(float a, float b, float tolerance) {
+  if (std::isnan(a) || std::isnan(b))
+    return std::isnan(a) && std::isnan(b);
+  return std::fabs(a - b) <= tolerance * std::max(1.0f, std::fabs(a));
+}
+
+/// Run one filter over the values, taking a result every send_every values, returns ns per value.
+template<typename Push, typename Result>
+static double run(const std::vector<float> &values, size_t send_every, std::vector<float> &results, Push push,
+                  Result result) {
+  results.clear();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < values.size(); i++) {
+    push(values[i]);
+    if ((i + 1) % send_every == 0)
+      results.push_back(result());
+  }
+  auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return elapsed / values.size();
+}
+
+static void report(const char *name, size_t window_size, size_t send_every, double old_ns, double new_ns,
+                   const std::vector<float> &old_results, const std::vector<float> &new_results, float tolerance) {
+  for (size_t i = 0; i < old_results.size(); i++) {
+    if (!same(old_results[i], new_results[i], tolerance)) {
+      printf("%s window %zu: result %zu differs, %f != %f\n", name, window_size, i, old_results[i], new_results[i]);
+      exit(1);
+    }
+  }
+  printf("%-8s window %4zu send_every %4zu: deque %8.1f ns/value, sliding window %8.1f ns/value\n", name,
+         window_size, send_every, old_ns, new_ns);
+}
+
+int main() {
+  // A noisy signal like a CT clamp sampled quickly, with a few NaN values from failed readings
+  std::mt19937 rng(42);
+  std::normal_distribution<float> noise(0.0f, 0.5f);
+  std::vector<float> values(VALUE_COUNT);
+  for (size_t i = 0; i < VALUE_COUNT; i++)
+    values[i] = (i % 997 == 0) ? NAN : 230.0f + 10.0f * std::sin(i * 0.01f) + noise(rng);
+
+  std::vector<float> old_results, new_results;
+  for (size_t window_size : {5, 15, 100, 500}) {
+    for (size_t send_every : {size_t(1), window_size}) {
+      {
+        DequeWindow old_window(window_size);
+        SortedSlidingWindow window(window_size);
+        double old_ns = run(
+            values, send_every, old_results, [&](float v) { old_window.push(v); },
+            [&]() { return median(old_window.sorted()); });
+        double new_ns = run(
+            values, send_every, new_results, [&](float v) { window.push(v); },
+            [&]() { return median(window.sorted()); });
+        report("median", window_size, send_every, old_ns, new_ns, old_results, new_results, 0.0f);
+      }
+      {
+        DequeWindow old_window(window_size);
+        SlidingWindowExtremum<std::less<float>> window(window_size);
+        double old_ns = run(
+            values, send_every, old_results, [&](float v) { old_window.push(v); }, [&]() { return old_window.min(); });
+        double new_ns = run(
+            values, send_every, new_results, [&](float v) { window.push(v); }, [&]() { return window.get(); });
+        report("min", window_size, send_every, old_ns, new_ns, old_results, new_results, 0.0f);
+      }
+      {
+        DequeWindow old_window(window_size);
+        SlidingWindowExtremum<std::greater<float>> window(window_size);
+        double old_ns = run(
+            values, send_every, old_results, [&](float v) { old_window.push(v); }, [&]() { return old_window.max(); });
+        double new_ns = run(
+            values, send_every, new_results, [&](float v) { window.push(v); }, [&]() { return window.get(); });
+        report("max", window_size, send_every, old_ns, new_ns, old_results, new_results, 0.0f);
+      }
+      {
+        DequeWindow old_window(window_size);
+        SlidingWindowSum window(window_size);
+        double old_ns = run(
+            values, send_every, old_results, [&](float v) { old_window.push(v); },
+            [&]() { return old_window.average(); });
+        double new_ns = run(
+            values, send_every, new_results, [&](float v) { window.push(v); }, [&]() { return window.average(); });
+        // The running sum adds and subtracts in a different order, which rounds differently
+        report("average", window_size, send_every, old_ns, new_ns, old_results, new_results, 1e-4f);
+      }
+    }
+  }
+
+  // A 60 s window of 1 kHz values, split into buckets the way TimeWindowFilter does
+  for (size_t buckets : {1, 6, 30}) {
+    const size_t bins = std::min<size_t>(std::max<size_t>(512 / buckets, 16), 64);
+    std::vector<StreamingHistogram> histograms(buckets, StreamingHistogram(bins));
+    std::vector<ValueSummary> summaries(buckets);
+    std::vector<float> window;
+    const size_t per_bucket = 60000 / buckets;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < buckets * per_bucket; i++) {
+      if (std::isnan(values[i]))
+        continue;
+      histograms[i / per_bucket].add(values[i]);
+      summaries[i / per_bucket].add(values[i]);
+      window.push_back(values[i]);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                (buckets * per_bucket);
+
+    ValueSummary summary;
+    std::vector<StreamingHistogram::Bin> merged;
+    for (size_t b = 0; b < buckets; b++) {
+      summary.merge(summaries[b]);
+      merged.insert(merged.end(), histograms[b].bins().begin(), histograms[b].bins().end());
+    }
+    std::sort(merged.begin(), merged.end(),
+              [](const StreamingHistogram::Bin &a, const StreamingHistogram::Bin &b) { return a.value < b.value; });
+    std::sort(window.begin(), window.end());
+    float max_error = 0.0f;
+    for (float quantile : {0.05f, 0.25f, 0.5f, 0.75f, 0.95f, 0.99f}) {
+      const float exact = window[std::min<size_t>(window.size() - 1, quantile * window.size())];
+      const float approx = StreamingHistogram::quantile(merged, summary.min, summary.max, quantile);
+      max_error = std::max(max_error, std::fabs(approx - exact));
+    }
+    printf("time window %2zu buckets of %2zu bins: %6.1f ns/value, largest quantile error %.3f (stddev %.3f)\n",
+           buckets, bins, ns, max_error, summary.stddev());
+  }
+  return 0;
+}